@@ -0,0 +1,98 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Shared Memory Pose Server */
+
+/*
+ * Opens every device and publishes them for other processes, which see them
+ * through the shared memory driver. Usage: openhmd_server [name] [--null]
+ * where --null also serves the null devices, for testing.
+ */
+
+#include <openhmd.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+void ohmd_sleep(double);
+
+static volatile sig_atomic_t quit = 0;
+
+static void handle_signal(int sig)
+{
+	quit = 1;
+}
+
+int main(int argc, char** argv)
+{
+	const char* name = "";
+	int serve_null = 0;
+
+	for(int i = 1; i < argc; i++){
+		if(strcmp(argv[i], "--null") == 0)
+			serve_null = 1;
+		else
+			name = argv[i];
+	}
+
+	ohmd_context* ctx = ohmd_ctx_create();
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	if(num_devices < 0){
+		printf("failed to probe devices: %s\n", ohmd_ctx_get_error(ctx));
+		return -1;
+	}
+
+	ohmd_device_settings* settings = ohmd_device_settings_create(ctx);
+	int auto_update = 1;
+	ohmd_device_settings_seti(settings, OHMD_IDS_AUTOMATIC_UPDATE, &auto_update);
+
+	int num_open = 0;
+	for(int i = 0; i < num_devices; i++){
+		int flags = 0;
+		ohmd_list_geti(ctx, i, OHMD_DEVICE_FLAGS, &flags);
+
+		// never serve what another server already serves
+		if(strncmp(ohmd_list_gets(ctx, i, OHMD_PATH), "shm:", 4) == 0)
+			continue;
+		if((flags & OHMD_DEVICE_FLAGS_NULL_DEVICE) && !serve_null)
+			continue;
+
+		if(!ohmd_list_open_device_s(ctx, i, settings)){
+			printf("failed to open %s: %s\n", ohmd_list_gets(ctx, i, OHMD_PRODUCT), ohmd_ctx_get_error(ctx));
+			continue;
+		}
+
+		printf("serving %s\n", ohmd_list_gets(ctx, i, OHMD_PRODUCT));
+		num_open++;
+	}
+
+	ohmd_device_settings_destroy(settings);
+
+	if(num_open == 0){
+		printf("no devices to serve\n");
+		ohmd_ctx_destroy(ctx);
+		return -1;
+	}
+
+	if(ohmd_ctx_publish(ctx, name) != OHMD_S_OK){
+		printf("failed to publish: %s\n", ohmd_ctx_get_error(ctx));
+		ohmd_ctx_destroy(ctx);
+		return -1;
+	}
+
+	signal(SIGINT, handle_signal);
+	signal(SIGTERM, handle_signal);
+
+	while(!quit){
+		ohmd_ctx_update(ctx);
+		ohmd_sleep(0.001);
+	}
+
+	ohmd_ctx_destroy(ctx);
+
+	return 0;
+}
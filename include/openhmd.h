@@ -65,6 +65,23 @@ typedef enum {
 	OHMD_GLSL_330_DISTORTION_FRAG_SRC = 3,
 	OHMD_GLSL_ES_DISTORTION_VERT_SRC = 4,
 	OHMD_GLSL_ES_DISTORTION_FRAG_SRC = 5,
+	/** Shaders drawing a mesh from ohmd_device_get_distortion_mesh, coords, uv_red, uv_green and uv_blue attributes. */
+	OHMD_GLSL_MESH_DISTORTION_VERT_SRC = 6,
+	OHMD_GLSL_MESH_DISTORTION_FRAG_SRC = 7,
+	OHMD_GLSL_330_MESH_DISTORTION_VERT_SRC = 8,
+	OHMD_GLSL_330_MESH_DISTORTION_FRAG_SRC = 9,
+	OHMD_GLSL_ES_MESH_DISTORTION_VERT_SRC = 10,
+	OHMD_GLSL_ES_MESH_DISTORTION_FRAG_SRC = 11,
+	/** Fragment shaders reading a map from ohmd_device_bake_distortion_map, use with the matching
+	    OHMD_GLSL_*_DISTORTION_VERT_SRC. */
+	OHMD_GLSL_MAP_DISTORTION_FRAG_SRC = 12,
+	OHMD_GLSL_330_MAP_DISTORTION_FRAG_SRC = 13,
+	OHMD_GLSL_ES_MAP_DISTORTION_FRAG_SRC = 14,
+	/** Vertex shaders drawing a distortion mesh reprojected by a timewarp uniform from ohmd_device_get_timewarp_matrix,
+	    use with the matching OHMD_GLSL_*_MESH_DISTORTION_FRAG_SRC. */
+	OHMD_GLSL_MESH_TIMEWARP_VERT_SRC = 15,
+	OHMD_GLSL_330_MESH_TIMEWARP_VERT_SRC = 16,
+	OHMD_GLSL_ES_MESH_TIMEWARP_VERT_SRC = 17,
 } ohmd_string_description;
 
 /** Standard controls. Note that this is not an index into the control state. 
@@ -163,6 +180,31 @@ typedef enum {
 	/** float[OHMD_CONTROL_COUNT] (get): Get the state of the device's controls. */
 	OHMD_CONTROLS_STATE                = 22,
 
+	/**
+	 * float[3] (get, set): One Euro output filter for the position, applied in ohmd_ctx_update.
+	 *
+	 * Values are: min cutoff (Hz, <= 0 disables the filter, default), beta (cutoff increase per m/s) and the cutoff
+	 * of the speed estimate (Hz). Lower min cutoff reduces jitter at rest, higher beta reduces lag while moving.
+	 **/
+	OHMD_POSE_FILTER_POSITION             = 23,
+
+	/**
+	 * float[3] (get, set): One Euro output filter for the rotation, applied in ohmd_ctx_update.
+	 *
+	 * Values are as for OHMD_POSE_FILTER_POSITION, with beta in cutoff increase per rad/s.
+	 **/
+	OHMD_POSE_FILTER_ROTATION             = 24,
+
+	/**
+	 * float[4] (get): Frustum of the left eye texture as tangents of the half angles <left, right, down, up>, all
+	 * positive, around the optical axis through the lens center. Unlike the default projection matrices these keep
+	 * the lens center where the distortion shaders expect it, horizontally and vertically.
+	 **/
+	OHMD_LEFT_EYE_FRUSTUM_TANGENTS        = 25,
+
+	/** float[4] (get): Frustum of the right eye texture, as OHMD_LEFT_EYE_FRUSTUM_TANGENTS. */
+	OHMD_RIGHT_EYE_FRUSTUM_TANGENTS       = 26,
+
 } ohmd_float_value;
 
 /** A collection of int value information types used for getting information with ohmd_device_geti(). */
@@ -198,14 +240,205 @@ typedef enum {
 	 * This can be used to fill in information about the device internally, such as Android, or for setting profiles.
 	 **/
 	OHMD_DRIVER_PROPERTIES	= 1,
+	/**
+	 * ohmd_sensor_samples* (set):
+	 * Feed a batch of IMU samples to the external sensor fusion driver, integrated in one go under a single lock.
+	 **/
+	OHMD_EXTERNAL_SENSOR_SAMPLES	= 2,
+	/**
+	 * const char* (set):
+	 * Name of a shared memory sample ring to drain on every update, see openhmd_ring.h. NULL to stop.
+	 * Also taken from the OHMD_EXTERNAL_RING environment variable when the device is opened. POSIX only.
+	 **/
+	OHMD_EXTERNAL_SENSOR_RING	= 3,
 } ohmd_data_value;
 
 typedef enum {
 	/** int[1] (set, default: 1): Set this to 0 to prevent OpenHMD from creating background threads to do automatic device ticking.
 	    Call ohmd_update(); must be called frequently, at least 10 times per second, if the background threads are disabled. */
 	OHMD_IDS_AUTOMATIC_UPDATE = 0,
+
+	/** int[1] (set, default: OHMD_FUSION_ENGINE_COMPLEMENTARY): Select the sensor fusion engine used for orientation
+	    tracking, one of ohmd_fusion_engine. Drivers without IMU based fusion ignore this setting. */
+	OHMD_IDS_FUSION_ENGINE = 1,
+
+	/** int[1] (set, default: 0): Set this to 1 to keep a buffer of pre-integrated IMU samples for the device,
+	    see ohmd_device_get_imu_preintegration. */
+	OHMD_IDS_IMU_PREINTEGRATION = 2,
 } ohmd_int_settings;
 
+/** Sensor fusion engines, used with OHMD_IDS_FUSION_ENGINE. */
+typedef enum {
+	/** Complementary filter with periodic gravity tilt correction. */
+	OHMD_FUSION_ENGINE_COMPLEMENTARY = 0,
+	/** Error-state Kalman filter estimating orientation and gyro bias online. */
+	OHMD_FUSION_ENGINE_ESKF = 1,
+} ohmd_fusion_engine;
+
+/**
+ * Pre-integrated IMU measurements between two samples, as used by visual-inertial odometry.
+ *
+ * Deltas are expressed in the body frame at start_time and integrate the calibrated (and bias corrected, if the
+ * fusion engine estimates the bias) gyro and the raw accelerometer, gravity is not removed. Matrices are 3x3 row major,
+ * the covariance is 9x9 row major ordered as rotation, velocity, position.
+ **/
+typedef struct {
+	/** Host time of the first and last sample used, seconds, see ohmd_get_time. */
+	double start_time, end_time;
+	/** Number of samples integrated. */
+	int num_samples;
+
+	/** Delta rotation as a quaternion (x, y, z, w). */
+	float delta_rotation[4];
+	/** Delta velocity in m/s. */
+	float delta_velocity[3];
+	/** Delta position in m. */
+	float delta_position[3];
+
+	float d_rotation_d_gyro_bias[9];
+	float d_velocity_d_gyro_bias[9];
+	float d_velocity_d_accel_bias[9];
+	float d_position_d_gyro_bias[9];
+	float d_position_d_accel_bias[9];
+
+	float covariance[81];
+} ohmd_imu_preintegration;
+
+/** One IMU sample, see OHMD_EXTERNAL_SENSOR_SAMPLES. Same units as OHMD_EXTERNAL_SENSOR_FUSION. */
+typedef struct {
+	/** Host time of the sample in seconds, see ohmd_get_time. If set the time since the previous sample gives the
+	    time step, 0 to use dt instead. */
+	double time;
+	/** Time since the previous sample in seconds. */
+	float dt;
+	float gyro[3];
+	float accel[3];
+	float mag[3];
+} ohmd_sensor_sample;
+
+/** A batch of IMU samples, oldest first. */
+typedef struct {
+	const ohmd_sensor_sample* samples;
+	int count;
+} ohmd_sensor_samples;
+
+/** A change of one control, see ohmd_device_get_control_events. */
+typedef struct {
+	/** Host time the driver decoded the change at, in seconds, see ohmd_get_time. */
+	double time;
+	/** Device time of the report carrying the change in seconds, from a device specific epoch and possibly
+	    wrapping, 0 if the device gives none. */
+	double device_time;
+	/** Index of the control, as in OHMD_CONTROLS_HINTS and OHMD_CONTROLS_STATE. */
+	int control;
+	/** The new value, as OHMD_CONTROLS_STATE gives it. */
+	float value;
+} ohmd_control_event;
+
+/** Eyes, used by the distortion helpers. */
+typedef enum {
+	OHMD_EYE_LEFT = 0,
+	OHMD_EYE_RIGHT = 1,
+} ohmd_eye;
+
+/** Frame events reported with ohmd_device_frame_event. */
+typedef enum {
+	/** The application starts rendering a frame, after reading the pose. */
+	OHMD_FRAME_BEGIN = 0,
+	/** The frame was handed to the compositor or swap chain. */
+	OHMD_FRAME_SUBMIT = 1,
+	/** The frame was presented, at the vblank it started scanning out on. Optional. */
+	OHMD_FRAME_PRESENT = 2,
+} ohmd_frame_event;
+
+/** Frame timing estimates, see ohmd_device_get_frame_timing. All values are seconds. */
+typedef struct {
+	/** Time between vblanks, measured from presents or else submits, 1/90 s until known. */
+	double display_period;
+	/** Time from frame begin to submit. */
+	double render_time;
+	/** Time from submit to the frame being displayed, one display period until presents are reported. */
+	double submit_to_display;
+	/** When the frame being rendered, or the next one if none is, will be displayed, see ohmd_get_time. */
+	double predicted_display_time;
+} ohmd_frame_timing;
+
+/** Color channels, used by the distortion helpers. */
+typedef enum {
+	OHMD_CHANNEL_RED = 0,
+	OHMD_CHANNEL_GREEN = 1,
+	OHMD_CHANNEL_BLUE = 2,
+} ohmd_color_channel;
+
+/**
+ * A vertex of a lens distortion mesh.
+ *
+ * Positions are in the eye viewport from [0,1]x[0,1], the same space as the texture coordinates fed to the
+ * distortion shaders. The per channel coordinates are where the eye texture has to be sampled and may lie outside
+ * [0,1], those parts of the screen should be black (e.g. by using a black clamp to border sampler).
+ **/
+typedef struct {
+	float coords[2];
+	float uv_red[2];
+	float uv_green[2];
+	float uv_blue[2];
+} ohmd_distortion_vertex;
+
+/** A lens distortion mesh, an indexed triangle list. */
+typedef struct {
+	int num_vertices;
+	int num_indices;
+	const ohmd_distortion_vertex* vertices;
+	const unsigned int* indices;
+} ohmd_distortion_mesh;
+
+/** Area meshes, see ohmd_device_get_area_mesh. */
+typedef enum {
+	/** Eye texture (render target) texels never sampled by the distortion, draw into the stencil or depth
+	    buffer before rendering the eye to skip shading them. */
+	OHMD_HIDDEN_AREA_MESH = 0,
+	/** Screen (eye viewport) pixels that show the eye texture, the distortion pass only needs to cover these,
+	    everything else is black. */
+	OHMD_VISIBLE_AREA_MESH = 1,
+} ohmd_area_mesh_type;
+
+/** An area mesh, an indexed triangle list of positions from [0,1]x[0,1] in the eye texture or viewport. */
+typedef struct {
+	int num_vertices;
+	int num_indices;
+	const float* vertices; // x, y pairs
+	const unsigned int* indices;
+} ohmd_area_mesh;
+
+/** An 8-bit per channel RGBA image, rows go from the bottom up like OpenGL textures. */
+typedef struct {
+	unsigned char* pixels;
+	int width;
+	int height;
+	/** Bytes from one row to the next. */
+	int stride;
+} ohmd_rgba_image;
+
+/** Texel formats of a baked distortion map, each texel holds two components (u, v). */
+typedef enum {
+	/** 32-bit float, e.g. GL_RG32F. */
+	OHMD_DISTORTION_MAP_FLOAT32 = 0,
+	/** 16-bit half float, e.g. GL_RG16F or GL_HALF_FLOAT_OES. */
+	OHMD_DISTORTION_MAP_FLOAT16 = 1,
+	/** 16-bit unsigned normalized, e.g. GL_RG16, decode with ohmd_distortion_map_info.decode. */
+	OHMD_DISTORTION_MAP_UNORM16 = 2,
+} ohmd_distortion_map_format;
+
+/** Uniforms needed to draw with a baked distortion map, see OHMD_GLSL_*_MAP_DISTORTION_FRAG_SRC. */
+typedef struct {
+	/** LensCenterUV: the lens center in the eye viewport from [0,1]x[0,1]. */
+	float lens_center[2];
+	/** AberrRatio: red, green and blue aberration relative to the green channel stored in the map. */
+	float aberr_ratio[3];
+	/** MapDecode: scale and offset from the stored value to texture coordinates. */
+	float decode[2];
+} ohmd_distortion_map_info;
+
 /** Device classes. */
 typedef enum 
 {
@@ -237,6 +470,20 @@ typedef struct ohmd_device ohmd_device;
 /** An opaque pointer to a structure representing arguments for a device. */
 typedef struct ohmd_device_settings ohmd_device_settings;
 
+/** An opaque pointer to a device being opened in the background, see ohmd_list_open_device_async. */
+typedef struct ohmd_open_request ohmd_open_request;
+
+/** State of a background open. */
+typedef enum {
+	OHMD_OPEN_PENDING = 0,
+	OHMD_OPEN_READY = 1,
+	OHMD_OPEN_FAILED = 2,
+} ohmd_open_state;
+
+/** Called from the opening thread when a background open finished, device is NULL unless the state is OHMD_OPEN_READY,
+    see ohmd_open_request_get_error for why it failed. */
+typedef void (*ohmd_open_callback)(ohmd_open_request* request, ohmd_open_state state, ohmd_device* device, void* user_data);
+
 /**
  * Create an OpenHMD context.
  *
@@ -290,6 +537,36 @@ OHMD_APIENTRYDLL void OHMD_APIENTRY ohmd_ctx_update(ohmd_context* ctx);
  **/
 OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_ctx_probe(ohmd_context* ctx);
 
+/**
+ * Publish the devices of a context to other processes.
+ *
+ * Every ohmd_ctx_update writes the pose, controls and timestamps of each open device into a POSIX shared memory
+ * segment. Other processes using OpenHMD list these devices through the shared memory driver, which reads the segment
+ * named by the OHMD_SHM_NAME environment variable, "/openhmd" by default, without locks or syscalls. That way one
+ * process owns the hardware and any number of processes get poses. Devices are removed from the segment when they are
+ * closed and the segment when publishing stops or the context is destroyed.
+ *
+ * @param ctx The context to publish.
+ * @param name The shared memory name, "" for the default or NULL to stop publishing.
+ * @return OHMD_S_OK on success, OHMD_S_UNSUPPORTED if the library was built without the shared memory driver,
+ *         OHMD_S_UNKNOWN_ERROR if the segment could not be created or another live process already publishes it.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_ctx_publish(ohmd_context* ctx, const char* name);
+
+/**
+ * Set the number of threads ohmd_ctx_update updates devices on.
+ *
+ * Only devices opened with automatic updates off are updated by ohmd_ctx_update. With more than one thread, devices on
+ * separate connections are updated in parallel by a pool of worker threads. Devices sharing a connection, like a
+ * headset and its controllers, are always updated one after the other on the same thread.
+ *
+ * @param ctx A (valid) OpenHMD context.
+ * @param count The number of threads including the calling one, 1 (the default) updates on the calling thread only.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for a count below 1,
+ *         OHMD_S_UNKNOWN_ERROR if the threads could not be started.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_ctx_set_update_threads(ohmd_context* ctx, int count);
+
 /**
  * Get string from openhmd.
  *
@@ -366,6 +643,53 @@ OHMD_APIENTRYDLL ohmd_device* OHMD_APIENTRY ohmd_list_open_device(ohmd_context*
  **/
 OHMD_APIENTRYDLL ohmd_device* OHMD_APIENTRY ohmd_list_open_device_s(ohmd_context* ctx, int index, ohmd_device_settings* settings);
 
+/**
+ * Open a device in the background.
+ *
+ * Returns right away and opens the device on a thread of its own, opening some devices takes seconds. Devices of
+ * different drivers open concurrently, devices of one driver one after the other. Once open the device is listed with
+ * the context like one opened by ohmd_list_open_device_s, it stays open when the request is destroyed and is closed
+ * with ohmd_close_device. All requests must be destroyed before the context.
+ *
+ * @param ctx A (probed) context.
+ * @param index An index, between 0 and the value returned from ohmd_ctx_probe.
+ * @param settings A pointer to a device settings struct, copied, or NULL for the defaults of ohmd_list_open_device.
+ * @param callback Called from the background thread when the open finished, NULL to only poll.
+ * @param user_data Passed to the callback.
+ * @return a request to poll and destroy, NULL on an invalid index or if the thread could not be started.
+ **/
+OHMD_APIENTRYDLL ohmd_open_request* OHMD_APIENTRY ohmd_list_open_device_async(ohmd_context* ctx, int index, ohmd_device_settings* settings,
+	ohmd_open_callback callback, void* user_data);
+
+/**
+ * Get the state of a background open.
+ *
+ * @param request The request returned by ohmd_list_open_device_async.
+ * @param device If not NULL, set to the device once the state is OHMD_OPEN_READY and NULL before.
+ * @return the state of the request, see ohmd_open_state.
+ **/
+OHMD_APIENTRYDLL ohmd_open_state OHMD_APIENTRY ohmd_open_request_poll(ohmd_open_request* request, ohmd_device** device);
+
+/**
+ * Get the error of a failed background open.
+ *
+ * Background opens don't set the error of the context, see ohmd_ctx_get_error.
+ *
+ * @param request The request returned by ohmd_list_open_device_async.
+ * @return a description of the failure once the state is OHMD_OPEN_FAILED, an empty string before, owned by the
+ *         request.
+ **/
+OHMD_APIENTRYDLL const char* OHMD_APIENTRY ohmd_open_request_get_error(ohmd_open_request* request);
+
+/**
+ * Destroy a background open request.
+ *
+ * Waits for the open to finish if it is still pending. A device it opened stays open.
+ *
+ * @param request The request to destroy.
+ **/
+OHMD_APIENTRYDLL void OHMD_APIENTRY ohmd_open_request_destroy(ohmd_open_request* request);
+
 /**
  * Specify int settings in a device settings struct.
  *
@@ -452,6 +776,219 @@ OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_device_seti(ohmd_device* device, ohmd_in
  **/
 OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_device_set_data(ohmd_device* device, ohmd_data_value type, const void* in);
 
+/**
+ * Get the control changes since the last call, oldest first.
+ *
+ * Drivers queue a change as soon as they decode it, so a press and release between two frames comes out as two
+ * events where OHMD_CONTROLS_STATE only shows the state at the time it is read. Drivers that don't queue changes
+ * themselves get them queued by the core after every device update. Up to 256 changes are kept, while the queue is
+ * full further changes are lost and the controls that changed are queued with their latest values once there's room.
+ *
+ * Never blocks on the device update, but must only be called from one thread at a time per device.
+ *
+ * @param device An open device.
+ * @param[out] events Space for max events.
+ * @param max The most events to return.
+ * @param[out] count The number of events returned.
+ * @return OHMD_S_OK on success, OHMD_S_UNSUPPORTED if the device has no controls,
+ *         OHMD_S_INVALID_PARAMETER for a max below 0.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_control_events(ohmd_device* device, ohmd_control_event* events, int max, int* count);
+
+/**
+ * Get the pre-integrated IMU measurements between two timestamps.
+ *
+ * The device must have been opened with OHMD_IDS_IMU_PREINTEGRATION enabled. The integration starts at the last
+ * sample at or before t0 and ends at the last sample at or before t1, about one second of samples is kept.
+ *
+ * @param device An open device.
+ * @param t0 Start time in seconds, see ohmd_get_time.
+ * @param t1 End time in seconds, see ohmd_get_time.
+ * @param[out] out The pre-integrated measurements.
+ * @return OHMD_S_OK on success, OHMD_S_UNSUPPORTED if not enabled for the device,
+ *         OHMD_S_INVALID_PARAMETER if t0 is no longer buffered or t1 < t0.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_imu_preintegration(ohmd_device* device, double t0, double t1, ohmd_imu_preintegration* out);
+
+/**
+ * Get a lens distortion mesh for one eye.
+ *
+ * The mesh evaluates the same model as the distortion shaders at every vertex, so drawing it with the
+ * OHMD_GLSL_*_MESH_DISTORTION_* shaders only costs three texture fetches per pixel. It is generated from the current
+ * screen, lens and distortion properties of the device and cached until they or the grid size change.
+ *
+ * @param device An open device.
+ * @param eye The eye to get the mesh for.
+ * @param grid_width Number of cells across, 1 to 1024.
+ * @param grid_height Number of cells down, 1 to 1024.
+ * @param[out] out The mesh, owned by the device and valid until the next call for the same eye or closing the device.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for a bad eye or grid size,
+ *         OHMD_S_UNKNOWN_ERROR if the mesh could not be allocated.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_distortion_mesh(ohmd_device* device, ohmd_eye eye, int grid_width, int grid_height, ohmd_distortion_mesh* out);
+
+/**
+ * Distort two eye images into the side by side panel image on the CPU.
+ *
+ * Runs the same distortion and chromatic aberration as the distortion shaders, sampling the eye images bilinearly
+ * with clamp to edge like the OpenGL example sets up, for headless or software rendered pipelines and as a
+ * reference for tests. Large panels are split over a few threads.
+ *
+ * @param device An open device.
+ * @param left The left eye image.
+ * @param right The right eye image.
+ * @param[out] panel The panel image, the left half shows the left eye.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for missing or empty images.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_composite(ohmd_device* device, const ohmd_rgba_image* left, const ohmd_rgba_image* right, ohmd_rgba_image* panel);
+
+/**
+ * Map points on the display through the lens distortion.
+ *
+ * Gives the eye texture coordinates the distortion shaders sample for a set of display positions, with the same
+ * distortion and aberration properties. Both are eye viewport coordinates from 0 to 1 with the origin at the lower
+ * left. Nothing is allocated, so this can be called per frame.
+ *
+ * @param device An open device.
+ * @param eye The eye the points are in.
+ * @param channel The color channel to map, they differ by the chromatic aberration.
+ * @param count Number of points.
+ * @param in count x,y pairs of display coordinates.
+ * @param[out] out count x,y pairs of eye texture coordinates, may be the same array as in.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for a bad eye, channel or count.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_distort_points(ohmd_device* device, ohmd_eye eye, ohmd_color_channel channel, int count, const float* in, float* out);
+
+/**
+ * Map eye texture points back to the display, the inverse of ohmd_device_distort_points.
+ *
+ * Solved with a fixed number of Newton steps on the radial distortion polynomial, accurate to float precision as long
+ * as the distortion doesn't fold over within the display.
+ *
+ * @param device An open device.
+ * @param eye The eye the points are in.
+ * @param channel The color channel to map.
+ * @param count Number of points.
+ * @param in count x,y pairs of eye texture coordinates.
+ * @param[out] out count x,y pairs of display coordinates, may be the same array as in.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for a bad eye, channel or count.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_undistort_points(ohmd_device* device, ohmd_eye eye, ohmd_color_channel channel, int count, const float* in, float* out);
+
+/**
+ * Get the recommended eye texture size.
+ *
+ * The size gives the requested number of texels per display pixel at the lens center, where the lens magnifies
+ * the most, taking the distortion model into account. Both eyes use the same size.
+ *
+ * @param device An open device.
+ * @param pixels_per_display_pixel Texel density at the lens center, 1.0 is a one to one match.
+ * @param[out] width Recommended eye texture width.
+ * @param[out] height Recommended eye texture height.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for a density <= 0.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_render_target_size(ohmd_device* device, float pixels_per_display_pixel, int* width, int* height);
+
+/**
+ * Report a frame event for frame pacing.
+ *
+ * Applications call this with OHMD_FRAME_BEGIN and OHMD_FRAME_SUBMIT for every frame, and OHMD_FRAME_PRESENT if the
+ * graphics API tells them when frames were presented. The estimates are medians over the last frames, so single
+ * hitches or missed vblanks don't disturb them.
+ *
+ * @param device An open device.
+ * @param event The event that happened.
+ * @param time When it happened, in seconds, see ohmd_get_time.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for an unknown event.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_frame_event(ohmd_device* device, ohmd_frame_event event, double time);
+
+/**
+ * Get the frame timing estimates and the predicted display time.
+ *
+ * The predicted display time is meant to be passed to pose prediction and ohmd_device_get_timewarp_matrix. With
+ * presents reported it is snapped to the vblanks.
+ *
+ * @param device An open device.
+ * @param[out] out The estimates.
+ * @return OHMD_S_OK.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_frame_timing(ohmd_device* device, ohmd_frame_timing* out);
+
+/**
+ * Get a rotational timewarp matrix for one eye.
+ *
+ * Reprojects a frame rendered with an older orientation to the newest orientation of the device, predicted from the
+ * angular velocity to the time the frame is scanned out. The result is a column major 3x3 matrix taking homogeneous
+ * eye texture coordinates at display time to the coordinates in the rendered frame, as used by the timewarp uniform of
+ * the OHMD_GLSL_*_MESH_TIMEWARP_VERT_SRC shaders. Only the rotation is corrected, the position is not.
+ *
+ * @param device An open device.
+ * @param eye The eye to get the matrix for.
+ * @param render_rotation The OHMD_ROTATION_QUAT the frame was rendered with.
+ * @param display_time When the frame is expected on the display, in seconds, see ohmd_get_time.
+ * @param[out] out A float[9] to store the matrix in.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for a bad eye, or the error of reading the rotation.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_timewarp_matrix(ohmd_device* device, ohmd_eye eye, const float* render_rotation, double display_time, float* out);
+
+/**
+ * Get a variable rate shading map for one eye texture.
+ *
+ * The lens compresses the image towards its edges, so the eye texture holds more texels than the screen shows
+ * there. For every tile the map gives the coarsest shading rate that still keeps the requested fraction of the
+ * texel density the screen can show, relative to the lens center; tiles the lens never shows get the coarsest
+ * rate. Values use the D3D12 and Vulkan encoding (log2(width) << 2) | log2(height), i.e. 0x0 for 1x1, 0x1 for
+ * 1x2, 0x4 for 2x1, 0x5 for 2x2, 0x6 for 2x4, 0x9 for 4x2 and 0xa for 4x4. Rows go from v = 0 up, flip them for
+ * APIs with a top left origin.
+ *
+ * @param device An open device.
+ * @param eye The eye to get the map for.
+ * @param width Number of tiles across the eye texture, 1 to 4096.
+ * @param height Number of tiles down the eye texture, 1 to 4096.
+ * @param quality Fraction of the needed density to keep, from 0 to 1, 1 never shades coarser than the display shows.
+ * @param[out] out width * height rates.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for a bad eye, size or quality.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_shading_rate_map(ohmd_device* device, ohmd_eye eye, int width, int height, float quality, unsigned char* out);
+
+/**
+ * Get the hidden or visible area mesh for one eye.
+ *
+ * The area is found from the lens model by following rays from the lens center to the edges of the eye viewport.
+ * The mesh errs on the side of drawing slightly too much: the hidden area never covers a texel any color channel
+ * samples and the visible area covers every pixel the shaders do not paint black.
+ *
+ * @param device An open device.
+ * @param eye The eye to get the mesh for.
+ * @param type OHMD_HIDDEN_AREA_MESH or OHMD_VISIBLE_AREA_MESH.
+ * @param segments Number of rays around the lens center, 8 to 1024.
+ * @param[out] out The mesh, owned by the device and valid until the next call for the same eye and type
+ *             or closing the device.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for a bad eye, type or segment count,
+ *         OHMD_S_UNSUPPORTED if the lens center lies outside the eye viewport.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_area_mesh(ohmd_device* device, ohmd_eye eye, ohmd_area_mesh_type type, int segments, ohmd_area_mesh* out);
+
+/**
+ * Bake the lens distortion into a lookup map for one eye.
+ *
+ * Each texel holds the texture coordinate the green channel is sampled from at that texel center, the red and
+ * blue channels are derived in the shader from the aberration ratios, so the OHMD_GLSL_*_MAP_DISTORTION_FRAG_SRC
+ * shaders need one dependent read of the (linearly filtered) map per pixel. Rows go from v = 0 up, like OpenGL.
+ *
+ * @param device An open device.
+ * @param eye The eye to bake the map for.
+ * @param width Map width in texels, 1 to 4096.
+ * @param height Map height in texels, 1 to 4096.
+ * @param format The texel format.
+ * @param[out] out width * height * 2 floats for OHMD_DISTORTION_MAP_FLOAT32, width * height * 2 uint16_t otherwise.
+ * @param[out] info The uniforms to draw the map with, can be NULL.
+ * @return OHMD_S_OK on success, OHMD_S_INVALID_PARAMETER for a bad eye, size or format.
+ **/
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_bake_distortion_map(ohmd_device* device, ohmd_eye eye, int width, int height,
+	ohmd_distortion_map_format format, void* out, ohmd_distortion_map_info* info);
+
 /**
  * Get the library version.
  *
@@ -478,6 +1015,13 @@ OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_require_version(int major, int m
  **/
 OHMD_APIENTRYDLL void OHMD_APIENTRY ohmd_sleep(double time);
 
+/**
+ * Get the current time of the monotonic host clock used to timestamp samples.
+ *
+ * @return Time in seconds.
+ **/
+OHMD_APIENTRYDLL double OHMD_APIENTRY ohmd_get_time(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,286 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/**
+ * \file openhmd_ring.h
+ * Shared memory sample ring for the external sensor fusion driver.
+ *
+ * A header only library for processes that produce IMU samples for an
+ * OpenHMD application. The producer pushes ohmd_sensor_sample entries into a
+ * single producer, single consumer ring in POSIX shared memory and the
+ * external driver drains it on every device update, see
+ * OHMD_EXTERNAL_SENSOR_RING. Pushing and draining never block and never make
+ * a syscall.
+ *
+ * POSIX only, compile with _POSIX_C_SOURCE >= 200112L (or _GNU_SOURCE) and
+ * link with -lrt where shm_open needs it. Requires the GCC __atomic builtins.
+ **/
+
+#ifndef OPENHMD_RING_H
+#define OPENHMD_RING_H
+
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "openhmd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OHMD_RING_MAGIC 0x52444d4f // "OMDR"
+#define OHMD_RING_VERSION 1
+
+/** Environment variable the external driver reads the name of a ring to drain from. */
+#define OHMD_RING_NAME_ENV "OHMD_EXTERNAL_RING"
+
+/** Shared layout, the samples follow the header. Indices run freely and are masked with capacity - 1. */
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t capacity;    // samples, power of two
+	uint32_t sample_size; // sizeof(ohmd_sensor_sample), different builds don't mix
+	char pad0[48];
+
+	// producer cache line
+	uint32_t head;
+	uint32_t dropped;     // samples not pushed because the ring was full
+	char pad1[56];
+
+	// consumer cache line
+	uint32_t tail;
+	char pad2[60];
+} ohmd_ring_header;
+
+/** A mapped ring, one per process and side. */
+typedef struct {
+	ohmd_ring_header* header;
+	ohmd_sensor_sample* samples;
+	uint32_t capacity; // as mapped, the shared header is not trusted for bounds
+	size_t size;
+} ohmd_ring;
+
+static inline size_t ohmd_ring_size(uint32_t capacity)
+{
+	return sizeof(ohmd_ring_header) + (size_t)capacity * sizeof(ohmd_sensor_sample);
+}
+
+static inline int ohmd_ring_map(ohmd_ring* ring, int fd, uint32_t capacity)
+{
+	size_t size = ohmd_ring_size(capacity);
+	void* mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if(mem == MAP_FAILED)
+		return -1;
+
+	ring->header = (ohmd_ring_header*)mem;
+	ring->samples = (ohmd_sensor_sample*)((char*)mem + sizeof(ohmd_ring_header));
+	ring->capacity = capacity;
+	ring->size = size;
+
+	return 0;
+}
+
+// mark a ring of another layout dead so attached consumers let go of it
+static inline void ohmd_ring_retire(int fd)
+{
+	void* mem = mmap(NULL, sizeof(ohmd_ring_header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(mem == MAP_FAILED)
+		return;
+
+	__atomic_store_n(&((ohmd_ring_header*)mem)->magic, 0, __ATOMIC_RELEASE);
+	munmap(mem, sizeof(ohmd_ring_header));
+}
+
+/**
+ * Create or reopen a ring as the producer.
+ *
+ * An existing ring of the same layout is kept, so a restarted producer
+ * continues where it left off and a consumer that is already attached keeps
+ * working. A ring of another layout is replaced, consumers reattach.
+ *
+ * @param ring The ring to fill in.
+ * @param name The shared memory object name, e.g. "/my-imu".
+ * @param capacity The number of samples, must be a power of two.
+ * @return 0 on success, -1 on error.
+ **/
+static inline int ohmd_ring_create(ohmd_ring* ring, const char* name, uint32_t capacity)
+{
+	if(capacity == 0 || (capacity & (capacity - 1)) != 0)
+		return -1;
+
+	size_t size = ohmd_ring_size(capacity);
+
+	int fd = shm_open(name, O_RDWR | O_CREAT, 0660);
+	if(fd < 0)
+		return -1;
+
+	struct stat st;
+	if(fstat(fd, &st) < 0){
+		close(fd);
+		return -1;
+	}
+
+	if(st.st_size != 0 && (size_t)st.st_size != size){
+		if((size_t)st.st_size >= sizeof(ohmd_ring_header))
+			ohmd_ring_retire(fd);
+
+		close(fd);
+		shm_unlink(name);
+
+		fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0660);
+		if(fd < 0)
+			return -1;
+
+		st.st_size = 0;
+	}
+
+	if(st.st_size == 0 && ftruncate(fd, size) < 0){
+		close(fd);
+		return -1;
+	}
+
+	if(ohmd_ring_map(ring, fd, capacity) < 0)
+		return -1;
+
+	ohmd_ring_header* h = ring->header;
+	if(__atomic_load_n(&h->magic, __ATOMIC_ACQUIRE) == OHMD_RING_MAGIC && h->version == OHMD_RING_VERSION &&
+	   h->capacity == capacity && h->sample_size == sizeof(ohmd_sensor_sample))
+		return 0;
+
+	__atomic_store_n(&h->magic, 0, __ATOMIC_RELEASE);
+	h->version = OHMD_RING_VERSION;
+	h->capacity = capacity;
+	h->sample_size = sizeof(ohmd_sensor_sample);
+	h->dropped = 0;
+	__atomic_store_n(&h->head, __atomic_load_n(&h->tail, __ATOMIC_ACQUIRE), __ATOMIC_RELAXED);
+	__atomic_store_n(&h->magic, OHMD_RING_MAGIC, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+/** Unmap a ring, either side. The shared memory object stays until ohmd_ring_unlink. */
+static inline void ohmd_ring_close(ohmd_ring* ring)
+{
+	if(ring->header)
+		munmap(ring->header, ring->size);
+
+	memset(ring, 0, sizeof(ohmd_ring));
+}
+
+/**
+ * Open an existing ring as the consumer.
+ *
+ * @param ring The ring to fill in.
+ * @param name The shared memory object name given to ohmd_ring_create.
+ * @return 0 on success, -1 if there is no ring by that name or it has a different layout.
+ **/
+static inline int ohmd_ring_open(ohmd_ring* ring, const char* name)
+{
+	int fd = shm_open(name, O_RDWR, 0);
+	if(fd < 0)
+		return -1;
+
+	struct stat st;
+	if(fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(ohmd_ring_header)){
+		close(fd);
+		return -1;
+	}
+
+	// the capacity follows from the size, the header is only checked against it
+	size_t count = ((size_t)st.st_size - sizeof(ohmd_ring_header)) / sizeof(ohmd_sensor_sample);
+	uint32_t capacity = (uint32_t)count;
+	if(count == 0 || count > UINT32_MAX || (capacity & (capacity - 1)) != 0 || ohmd_ring_size(capacity) != (size_t)st.st_size){
+		close(fd);
+		return -1;
+	}
+
+	if(ohmd_ring_map(ring, fd, capacity) < 0)
+		return -1;
+
+	ohmd_ring_header* h = ring->header;
+	if(__atomic_load_n(&h->magic, __ATOMIC_ACQUIRE) != OHMD_RING_MAGIC || h->version != OHMD_RING_VERSION ||
+	   h->sample_size != sizeof(ohmd_sensor_sample) || h->capacity != capacity){
+		ohmd_ring_close(ring);
+		return -1;
+	}
+
+	return 0;
+}
+
+/** Remove the shared memory object, usually done by the producer on shutdown. */
+static inline void ohmd_ring_unlink(const char* name)
+{
+	shm_unlink(name);
+}
+
+/**
+ * Push one sample, producer only.
+ *
+ * @param ring The ring.
+ * @param sample The sample, see ohmd_sensor_sample.
+ * @return 0 on success, -1 if the ring is full and the sample was dropped.
+ **/
+static inline int ohmd_ring_push(ohmd_ring* ring, const ohmd_sensor_sample* sample)
+{
+	ohmd_ring_header* h = ring->header;
+	uint32_t head = __atomic_load_n(&h->head, __ATOMIC_RELAXED);
+	uint32_t tail = __atomic_load_n(&h->tail, __ATOMIC_ACQUIRE);
+
+	if(head - tail >= ring->capacity){
+		__atomic_store_n(&h->dropped, h->dropped + 1, __ATOMIC_RELAXED);
+		return -1;
+	}
+
+	ring->samples[head & (ring->capacity - 1)] = *sample;
+	__atomic_store_n(&h->head, head + 1, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+/**
+ * Pop up to max samples, oldest first, consumer only.
+ *
+ * @param ring The ring.
+ * @param out Space for max samples.
+ * @param max The most samples to pop.
+ * @return The number of samples popped, -1 if the producer replaced the ring and it needs to be reopened.
+ **/
+static inline int ohmd_ring_pop(ohmd_ring* ring, ohmd_sensor_sample* out, int max)
+{
+	ohmd_ring_header* h = ring->header;
+	if(__atomic_load_n(&h->magic, __ATOMIC_ACQUIRE) != OHMD_RING_MAGIC)
+		return -1;
+
+	uint32_t tail = __atomic_load_n(&h->tail, __ATOMIC_RELAXED);
+	uint32_t head = __atomic_load_n(&h->head, __ATOMIC_ACQUIRE);
+	uint32_t available = head - tail;
+
+	// a reinitialized or corrupt ring, start over at the producer's position
+	if(available > ring->capacity){
+		__atomic_store_n(&h->tail, head, __ATOMIC_RELEASE);
+		return 0;
+	}
+
+	int count = available < (uint32_t)max ? (int)available : max;
+	for(int i = 0; i < count; i++)
+		out[i] = ring->samples[(tail + i) & (ring->capacity - 1)];
+
+	__atomic_store_n(&h->tail, tail + count, __ATOMIC_RELEASE);
+
+	return count;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Device to Host Clock Synchronization Implementation */
+
+/*
+ * Every report gives a pair of (device time, host arrival time). The arrival is
+ * always later than the true host time of the sample by the USB and scheduling
+ * latency, which is strictly positive and noisy. So the mapping is estimated as
+ * the lower envelope of the observed offsets: the minimum offset is kept per
+ * time bucket, the drift is a least squares fit through those minima and the
+ * offset is then lowered until no minimum lies below the line.
+ */
+
+#include <string.h>
+#include "openhmdi.h"
+
+#define BUCKET_LEN 0.1     // seconds of host time per envelope point
+#define MAX_DRIFT 1e-3     // 1000 ppm, anything above is a bad fit
+#define RESYNC_EARLY 0.01  // arrival predicted this much too late means the device clock jumped
+#define RESYNC_LATE 0.5    // as does an apparent latency this large
+
+static int64_t unwrap(const clock_sync* me, uint64_t ticks)
+{
+	uint64_t delta = (ticks - me->last_ticks) & me->tick_mask;
+
+	// deltas over half the counter range are samples from before the last one
+	if(delta > (me->tick_mask >> 1))
+		return me->last_unwrapped - (int64_t)((me->tick_mask - delta) + 1);
+
+	return me->last_unwrapped + (int64_t)delta;
+}
+
+static void push_bucket(clock_sync* me)
+{
+	me->win_x[me->win_at] = me->bucket_x;
+	me->win_y[me->win_at] = me->bucket_y;
+	me->win_at = (me->win_at + 1) % CLOCK_SYNC_WINDOW;
+	if(me->win_count < CLOCK_SYNC_WINDOW)
+		me->win_count++;
+}
+
+static void fit(clock_sync* me)
+{
+	int n = me->win_count + 1;
+	double sx = me->bucket_x, sy = me->bucket_y;
+
+	for(int i = 0; i < me->win_count; i++){
+		sx += me->win_x[i];
+		sy += me->win_y[i];
+	}
+
+	double mx = sx / n, my = sy / n;
+	double sxx = POW2(me->bucket_x - mx), sxy = (me->bucket_x - mx) * (me->bucket_y - my);
+
+	for(int i = 0; i < me->win_count; i++){
+		sxx += POW2(me->win_x[i] - mx);
+		sxy += (me->win_x[i] - mx) * (me->win_y[i] - my);
+	}
+
+	// the drift needs a couple of seconds of history to be meaningful
+	double drift = 0;
+	if(me->win_count >= 4 && sxx > 0){
+		drift = sxy / sxx;
+		if(drift > MAX_DRIFT)
+			drift = MAX_DRIFT;
+		else if(drift < -MAX_DRIFT)
+			drift = -MAX_DRIFT;
+	}
+
+	double offset = me->bucket_y - drift * me->bucket_x;
+	for(int i = 0; i < me->win_count; i++){
+		double o = me->win_y[i] - drift * me->win_x[i];
+		if(o < offset)
+			offset = o;
+	}
+
+	me->drift = drift;
+	me->offset = offset;
+}
+
+void oclock_sync_init(clock_sync* me, double ticks_per_sec, int tick_bits)
+{
+	memset(me, 0, sizeof(clock_sync));
+
+	me->ticks_per_sec = ticks_per_sec;
+	me->tick_mask = tick_bits >= 64 ? UINT64_MAX : (((uint64_t)1 << tick_bits) - 1);
+}
+
+double oclock_sync_update(clock_sync* me, uint64_t ticks, double host_time)
+{
+	ticks &= me->tick_mask;
+
+	if(me->valid){
+		int64_t unwrapped = unwrap(me, ticks);
+		double x = unwrapped / me->ticks_per_sec;
+		double predicted = x + me->offset + me->drift * x;
+
+		if(predicted - host_time > RESYNC_EARLY || host_time - predicted > RESYNC_LATE){
+			LOGD("device clock jumped by %f s, resynchronizing", host_time - predicted);
+			me->valid = false;
+		}
+	}
+
+	if(!me->valid){
+		uint64_t mask = me->tick_mask;
+		double tps = me->ticks_per_sec;
+
+		memset(me, 0, sizeof(clock_sync));
+		me->ticks_per_sec = tps;
+		me->tick_mask = mask;
+		me->valid = true;
+		me->last_ticks = ticks;
+		me->last_unwrapped = 0;
+	}
+
+	int64_t unwrapped = unwrap(me, ticks);
+
+	// only move forward, late samples keep the unwrap reference
+	if(unwrapped > me->last_unwrapped){
+		me->last_unwrapped = unwrapped;
+		me->last_ticks = ticks;
+	}
+
+	double x = unwrapped / me->ticks_per_sec;
+	double y = host_time - x;
+
+	if(me->bucket_valid && host_time - me->bucket_start >= BUCKET_LEN){
+		push_bucket(me);
+		me->bucket_valid = false;
+	}
+
+	if(!me->bucket_valid){
+		me->bucket_start = host_time;
+		me->bucket_x = x;
+		me->bucket_y = y;
+		me->bucket_valid = true;
+	} else if(y < me->bucket_y){
+		me->bucket_x = x;
+		me->bucket_y = y;
+	}
+
+	fit(me);
+
+	return x + me->offset + me->drift * x;
+}
+
+double oclock_sync_to_host(const clock_sync* me, uint64_t ticks)
+{
+	if(!me->valid)
+		return 0;
+
+	double x = unwrap(me, ticks & me->tick_mask) / me->ticks_per_sec;
+	return x + me->offset + me->drift * x;
+}
@@ -0,0 +1,42 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Device to Host Clock Synchronization */
+
+
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CLOCK_SYNC_WINDOW 64
+
+typedef struct {
+	double ticks_per_sec;
+	uint64_t tick_mask;
+
+	bool valid;
+	uint64_t last_ticks;    // last raw device tick
+	int64_t last_unwrapped; // device ticks since the first update
+
+	// lowest observed (host - device) offset within the current bucket
+	double bucket_start, bucket_x, bucket_y;
+	bool bucket_valid;
+
+	// lower envelope points of past buckets
+	double win_x[CLOCK_SYNC_WINDOW], win_y[CLOCK_SYNC_WINDOW];
+	int win_at, win_count;
+
+	// host = x + offset + drift * x, with x the device time in seconds since the first update
+	double offset, drift;
+} clock_sync;
+
+void oclock_sync_init(clock_sync* me, double ticks_per_sec, int tick_bits);
+double oclock_sync_update(clock_sync* me, uint64_t ticks, double host_time);
+double oclock_sync_to_host(const clock_sync* me, uint64_t ticks);
+
+#endif
@@ -0,0 +1,857 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Lens Distortion Implementation */
+
+/*
+ * CPU side evaluation of the model in the universal distortion shaders, see
+ * shaders.c. Coordinates are eye viewport coordinates from [0,1]x[0,1], the
+ * lens parameters are derived from the device properties the same way the
+ * OpenGL example sets the shader uniforms.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "openhmdi.h"
+
+#define MAX_GRID_SIZE 1024
+#define MAX_MAP_SIZE 4096
+#define MIN_AREA_SEGMENTS 8
+#define MAX_AREA_SEGMENTS 1024
+#define MAX_BAND_THREADS 4
+#define TEXELS_PER_THREAD 65536 // below this starting a thread costs more than it saves
+#define UNDISTORT_ITERATIONS 6
+
+// unorm16 maps cover texture coordinates from -0.5 to 1.5, anything further out is off the texture either way
+#define UNORM16_SCALE 2.0f
+#define UNORM16_OFFSET -0.5f
+
+void odistortion_get_params(const ohmd_device* device, ohmd_eye eye, distortion_params* out)
+{
+	const ohmd_device_properties* props = &device->properties;
+
+	out->viewport_scale[0] = props->hsize / 2.0f;
+	out->viewport_scale[1] = props->vsize;
+
+	// assuming the eye separation is the distance between the lens centers
+	float left = out->viewport_scale[0] - props->lens_sep / 2.0f;
+	float right = props->lens_sep / 2.0f;
+
+	out->lens_center[0] = eye == OHMD_EYE_LEFT ? left : right;
+	out->lens_center[1] = props->lens_vpos;
+	out->warp_scale = OHMD_MAX(left, right);
+
+	memcpy(out->warp_param, props->universal_distortion_k, sizeof(out->warp_param));
+	memcpy(out->aberr, props->universal_aberration_k, sizeof(out->aberr));
+}
+
+/*
+ * The eye texture covers the eye viewport and is rendered with the vertical
+ * field of view and aspect of the device, so texture positions are linear in
+ * the view tangent with the optical axis at the lens center.
+ */
+void odistortion_get_tangents(const ohmd_device* device, ohmd_eye eye, float* out)
+{
+	const ohmd_device_properties* props = &device->properties;
+	distortion_params p;
+	odistortion_get_params(device, eye, &p);
+
+	float half_tan = tanf(props->fov / 2.0f);
+	float tan_per_m_x = 2.0f * props->ratio * half_tan / p.viewport_scale[0];
+	float tan_per_m_y = 2.0f * half_tan / p.viewport_scale[1];
+
+	out[0] = p.lens_center[0] * tan_per_m_x;
+	out[1] = (p.viewport_scale[0] - p.lens_center[0]) * tan_per_m_x;
+	out[2] = p.lens_center[1] * tan_per_m_y;
+	out[3] = (p.viewport_scale[1] - p.lens_center[1]) * tan_per_m_y;
+}
+
+void odistortion_get_render_target_size(const ohmd_device* device, float density, int* width, int* height)
+{
+	const ohmd_device_properties* props = &device->properties;
+
+	// at the lens center a screen step of dr samples the texture dr * d * aberr_g away
+	float scale = fabsf(props->universal_distortion_k[3] * props->universal_aberration_k[1]);
+	if(scale <= 0)
+		scale = 1.0f;
+
+	*width = (int)ceilf(props->hres / 2.0f * density / scale);
+	*height = (int)ceilf(props->vres * density / scale);
+}
+
+/*
+ * Rotation only reprojection of an eye texture. A display time texture position
+ * is turned into a view direction, (tan_x, tan_y, -1) looking down -Z, rotated
+ * into the view the frame was rendered with and projected back. All three steps
+ * are linear in homogeneous coordinates: H = K * R * K^-1 with
+ * K = [1/W 0 -l/W; 0 1/H -d/H; 0 0 -1], W = l + r, H = d + u and R the
+ * rotation from the display view to the render view.
+ */
+void odistortion_timewarp_matrix(const float* tangents, const quatf* render_rotation, const quatf* display_rotation, float* out)
+{
+	const float l = tangents[0], d = tangents[2];
+	const float w = tangents[0] + tangents[1], h = tangents[2] + tangents[3];
+
+	quatf delta;
+	oquatf_diff(render_rotation, display_rotation, &delta);
+	oquatf_normalize_me(&delta);
+
+	float rot[4][4];
+	vec3f zero = {{0, 0, 0}};
+	oquatf_get_mat4x4(&delta, &zero, rot);
+
+	// K^-1 as columns
+	const float kinv[3][3] = {{w, 0, 0}, {0, h, 0}, {-l, -d, -1}};
+	const float k[3][3] = {{1.0f / w, 0, -l / w}, {0, 1.0f / h, -d / h}, {0, 0, -1}};
+
+	for(int col = 0; col < 3; col++){
+		float v[3];
+		for(int i = 0; i < 3; i++)
+			v[i] = rot[i][0] * kinv[col][0] + rot[i][1] * kinv[col][1] + rot[i][2] * kinv[col][2];
+
+		// column major like the other matrices handed to OpenGL
+		for(int i = 0; i < 3; i++)
+			out[col * 3 + i] = k[i][0] * v[0] + k[i][1] * v[1] + k[i][2] * v[2];
+	}
+}
+
+// maps count points of a row starting at (u0, v) to the red, green and blue source coordinates,
+// six floats written every stride floats. The loop has no branches so the compiler can vectorize it.
+void odistortion_map_row(const distortion_params* p, int count, float u0, float du, float v, float* out, int stride)
+{
+	const float lcx = p->lens_center[0], lcy = p->lens_center[1];
+	const float vsx = p->viewport_scale[0], vsy = p->viewport_scale[1];
+	const float inv_vsx = 1.0f / vsx, inv_vsy = 1.0f / vsy;
+	const float ws = p->warp_scale, inv_ws = 1.0f / ws;
+	const float a = p->warp_param[0], b = p->warp_param[1], c = p->warp_param[2], d = p->warp_param[3];
+	const float ab_r = p->aberr[0], ab_g = p->aberr[1], ab_b = p->aberr[2];
+
+	const float ry = (v * vsy - lcy) * inv_ws;
+
+	for(int i = 0; i < count; i++){
+		float rx = ((u0 + du * i) * vsx - lcx) * inv_ws;
+		float r_mag = sqrtf(rx * rx + ry * ry);
+		float k = (d + r_mag * (c + r_mag * (b + r_mag * a))) * ws;
+		float dx = rx * k, dy = ry * k;
+
+		float* o = out + i * stride;
+		o[0] = (lcx + ab_r * dx) * inv_vsx;
+		o[1] = (lcy + ab_r * dy) * inv_vsy;
+		o[2] = (lcx + ab_g * dx) * inv_vsx;
+		o[3] = (lcy + ab_g * dy) * inv_vsy;
+		o[4] = (lcx + ab_b * dx) * inv_vsx;
+		o[5] = (lcy + ab_b * dy) * inv_vsy;
+	}
+}
+
+// like odistortion_map_row for the green channel only, two floats per point
+void odistortion_map_row_green(const distortion_params* p, int count, float u0, float du, float v, float* out)
+{
+	const float lcx = p->lens_center[0], lcy = p->lens_center[1];
+	const float vsx = p->viewport_scale[0], vsy = p->viewport_scale[1];
+	const float ws = p->warp_scale, inv_ws = 1.0f / ws;
+	const float a = p->warp_param[0], b = p->warp_param[1], c = p->warp_param[2], d = p->warp_param[3];
+	const float sx = p->aberr[1] * ws / vsx, sy = p->aberr[1] * ws / vsy;
+	const float ox = lcx / vsx, oy = lcy / vsy;
+
+	const float ry = (v * vsy - lcy) * inv_ws;
+	const float ry2 = ry * ry;
+	const float out_y = ry * sy;
+
+	for(int i = 0; i < count; i++){
+		float rx = ((u0 + du * i) * vsx - lcx) * inv_ws;
+		float r_mag = sqrtf(rx * rx + ry2);
+		float k = d + r_mag * (c + r_mag * (b + r_mag * a));
+
+		out[i * 2 + 0] = ox + rx * k * sx;
+		out[i * 2 + 1] = oy + out_y * k;
+	}
+}
+
+// screen to texture coordinates for count points of one channel, in and out may be the same array
+void odistortion_distort_points(const distortion_params* p, int channel, int count, const float* in, float* out)
+{
+	const float lcx = p->lens_center[0], lcy = p->lens_center[1];
+	const float vsx = p->viewport_scale[0], vsy = p->viewport_scale[1];
+	const float ws = p->warp_scale, inv_ws = 1.0f / ws;
+	const float a = p->warp_param[0], b = p->warp_param[1], c = p->warp_param[2], d = p->warp_param[3];
+	const float sx = p->aberr[channel] * ws / vsx, sy = p->aberr[channel] * ws / vsy;
+	const float ox = lcx / vsx, oy = lcy / vsy;
+
+	for(int i = 0; i < count; i++){
+		float rx = (in[i * 2 + 0] * vsx - lcx) * inv_ws;
+		float ry = (in[i * 2 + 1] * vsy - lcy) * inv_ws;
+		float r_mag = sqrtf(rx * rx + ry * ry);
+		float k = d + r_mag * (c + r_mag * (b + r_mag * a));
+
+		out[i * 2 + 0] = ox + rx * k * sx;
+		out[i * 2 + 1] = oy + ry * k * sy;
+	}
+}
+
+/*
+ * The model scales radially, so inverting it only means solving the scalar
+ * f(r) = r * K(r) = t for the screen radius r of a texture radius t. Newton's
+ * method from r = t / d converges in a few steps for any lens that doesn't fold
+ * over, so a fixed count is run to keep the loop free of branches.
+ */
+void odistortion_undistort_points(const distortion_params* p, int channel, int count, const float* in, float* out)
+{
+	const float lcx = p->lens_center[0], lcy = p->lens_center[1];
+	const float vsx = p->viewport_scale[0], vsy = p->viewport_scale[1];
+	const float ws = p->warp_scale;
+	const float a = p->warp_param[0], b = p->warp_param[1], c = p->warp_param[2], d = p->warp_param[3];
+	const float sx = vsx / (p->aberr[channel] * ws), sy = vsy / (p->aberr[channel] * ws);
+	const float ox = lcx / vsx, oy = lcy / vsy;
+
+	for(int i = 0; i < count; i++){
+		float tx = (in[i * 2 + 0] - ox) * sx;
+		float ty = (in[i * 2 + 1] - oy) * sy;
+		float t = sqrtf(tx * tx + ty * ty);
+
+		float r = t / d;
+		for(int j = 0; j < UNDISTORT_ITERATIONS; j++){
+			float f = r * (d + r * (c + r * (b + r * a))) - t;
+			float df = d + r * (2.0f * c + r * (3.0f * b + r * 4.0f * a));
+			r -= f / OHMD_MAX(df, 1e-6f);
+		}
+
+		// r / t tends to 1 / d at the center
+		float scale = t > 1e-12f ? r / t : 1.0f / d;
+
+		out[i * 2 + 0] = (lcx + tx * scale * ws) / vsx;
+		out[i * 2 + 1] = (lcy + ty * scale * ws) / vsy;
+	}
+}
+
+void odistortion_mesh_free(distortion_mesh* me)
+{
+	free(me->vertices);
+	free(me->indices);
+	memset(me, 0, sizeof(distortion_mesh));
+}
+
+ohmd_status odistortion_mesh_update(ohmd_context* ctx, distortion_mesh* me, const distortion_params* p, int grid_width, int grid_height)
+{
+	if(grid_width < 1 || grid_width > MAX_GRID_SIZE || grid_height < 1 || grid_height > MAX_GRID_SIZE){
+		ohmd_set_error(ctx, "invalid distortion mesh grid size: %dx%d", grid_width, grid_height);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	if(me->valid && me->grid_width == grid_width && me->grid_height == grid_height &&
+	   memcmp(&me->params, p, sizeof(distortion_params)) == 0)
+		return OHMD_S_OK;
+
+	int cols = grid_width + 1, rows = grid_height + 1;
+
+	if(!me->valid || me->grid_width != grid_width || me->grid_height != grid_height){
+		odistortion_mesh_free(me);
+
+		me->vertices = ohmd_alloc(ctx, sizeof(ohmd_distortion_vertex) * cols * rows);
+		me->indices = ohmd_alloc(ctx, sizeof(unsigned int) * 6 * grid_width * grid_height);
+		if(!me->vertices || !me->indices){
+			odistortion_mesh_free(me);
+			return OHMD_S_UNKNOWN_ERROR;
+		}
+
+		// the topology only depends on the grid size
+		unsigned int* idx = me->indices;
+		for(int y = 0; y < grid_height; y++){
+			for(int x = 0; x < grid_width; x++){
+				unsigned int i = y * cols + x;
+				*idx++ = i;
+				*idx++ = i + 1;
+				*idx++ = i + cols;
+				*idx++ = i + 1;
+				*idx++ = i + cols + 1;
+				*idx++ = i + cols;
+			}
+		}
+
+		for(int y = 0; y < rows; y++){
+			for(int x = 0; x < cols; x++){
+				ohmd_distortion_vertex* vtx = me->vertices + y * cols + x;
+				vtx->coords[0] = x / (float)grid_width;
+				vtx->coords[1] = y / (float)grid_height;
+			}
+		}
+
+		me->grid_width = grid_width;
+		me->grid_height = grid_height;
+	}
+
+	for(int y = 0; y < rows; y++)
+		odistortion_map_row(p, cols, 0, 1.0f / grid_width, y / (float)grid_height,
+			me->vertices[y * cols].uv_red, sizeof(ohmd_distortion_vertex) / sizeof(float));
+
+	me->params = *p;
+	me->valid = true;
+
+	return OHMD_S_OK;
+}
+
+// radial distortion factor at normalized radius r, the shader's HmdWarpParam polynomial
+static float warp_factor(const distortion_params* p, float r)
+{
+	return p->warp_param[3] + r * (p->warp_param[2] + r * (p->warp_param[1] + r * p->warp_param[0]));
+}
+
+static int compare_float(const void* a, const void* b)
+{
+	float fa = *(const float*)a, fb = *(const float*)b;
+	return fa < fb ? -1 : (fa > fb ? 1 : 0);
+}
+
+void odistortion_area_free(distortion_area* me)
+{
+	free(me->vertices);
+	free(me->indices);
+	memset(me, 0, sizeof(distortion_area));
+}
+
+/*
+ * Works in the lens centered space of the shader normalized by the warp scale,
+ * where the eye viewport and the eye texture are the same rectangle around the
+ * origin and the warp only scales along rays from the origin. For every ray the
+ * distance to the rectangle edge is s, the texture is sampled out to s * K(s)
+ * times the largest channel aberration, and screen pixels stay visible while
+ * their green sample r * K(r) stays within s.
+ */
+typedef struct {
+	const distortion_params* p;
+	float x0, x1, y0, y1;
+	float max_aberr, green_aberr;
+	bool hidden;
+} area_ctx;
+
+// distance to the rectangle edge and to the area boundary along the ray at angle a
+static void area_ray(const area_ctx* c, float a, float* edge, float* boundary)
+{
+	float dx = cosf(a), dy = sinf(a);
+
+	float s = INFINITY;
+	if(dx > 0) s = OHMD_MIN(s, c->x1 / dx);
+	if(dx < 0) s = OHMD_MIN(s, c->x0 / dx);
+	if(dy > 0) s = OHMD_MIN(s, c->y1 / dy);
+	if(dy < 0) s = OHMD_MIN(s, c->y0 / dy);
+
+	*edge = s;
+
+	if(c->hidden){
+		*boundary = s * fabsf(warp_factor(c->p, s)) * c->max_aberr;
+	} else if(s * fabsf(warp_factor(c->p, s)) * c->green_aberr <= s){
+		*boundary = INFINITY;
+	} else {
+		// largest radius still sampling inside the texture, the warp grows monotonically with the radius
+		float lo = 0, hi = s;
+		for(int j = 0; j < 24; j++){
+			float mid = 0.5f * (lo + hi);
+			if(mid * fabsf(warp_factor(c->p, mid)) * c->green_aberr <= s)
+				lo = mid;
+			else
+				hi = mid;
+		}
+		*boundary = hi;
+	}
+}
+
+static bool area_on_edge(const area_ctx* c, float a)
+{
+	float edge, boundary;
+	area_ray(c, a, &edge, &boundary);
+	return boundary >= edge;
+}
+
+ohmd_status odistortion_area_update(ohmd_context* ctx, distortion_area* me, const distortion_params* p, ohmd_area_mesh_type type, int segments)
+{
+	if(segments < MIN_AREA_SEGMENTS || segments > MAX_AREA_SEGMENTS){
+		ohmd_set_error(ctx, "invalid area mesh segment count: %d", segments);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	if(me->valid && me->segments == segments && memcmp(&me->params, p, sizeof(distortion_params)) == 0)
+		return OHMD_S_OK;
+
+	const float ws = p->warp_scale;
+	area_ctx c;
+	c.p = p;
+	c.x0 = -p->lens_center[0] / ws;
+	c.x1 = (p->viewport_scale[0] - p->lens_center[0]) / ws;
+	c.y0 = -p->lens_center[1] / ws;
+	c.y1 = (p->viewport_scale[1] - p->lens_center[1]) / ws;
+	c.max_aberr = OHMD_MAX(fabsf(p->aberr[0]), OHMD_MAX(fabsf(p->aberr[1]), fabsf(p->aberr[2])));
+	c.green_aberr = fabsf(p->aberr[1]);
+	c.hidden = type == OHMD_HIDDEN_AREA_MESH;
+
+	if(c.x0 >= 0 || c.x1 <= 0 || c.y0 >= 0 || c.y1 <= 0){
+		ohmd_set_error(ctx, "lens center outside of the eye viewport");
+		return OHMD_S_UNSUPPORTED;
+	}
+
+	// evenly spaced rays plus the corners, so the outer edge follows the rectangle exactly,
+	// plus the kinks where the boundary meets the edge, found below
+	int base_rays = segments + 4;
+	float* angles = ohmd_alloc(ctx, sizeof(float) * base_rays * 2);
+	if(!angles)
+		return OHMD_S_UNKNOWN_ERROR;
+
+	for(int i = 0; i < segments; i++)
+		angles[i] = 2.0f * (float)M_PI * i / segments - (float)M_PI;
+	angles[segments + 0] = atan2f(c.y0, c.x0);
+	angles[segments + 1] = atan2f(c.y0, c.x1);
+	angles[segments + 2] = atan2f(c.y1, c.x1);
+	angles[segments + 3] = atan2f(c.y1, c.x0);
+	qsort(angles, base_rays, sizeof(float), compare_float);
+
+	int num_rays = base_rays;
+	for(int i = 0; i < base_rays; i++){
+		float a0 = angles[i];
+		float a1 = i + 1 < base_rays ? angles[i + 1] : angles[0] + 2.0f * (float)M_PI;
+		bool edge0 = area_on_edge(&c, a0);
+
+		if(edge0 == area_on_edge(&c, a1))
+			continue;
+
+		for(int j = 0; j < 24; j++){
+			float mid = 0.5f * (a0 + a1);
+			if(area_on_edge(&c, mid) == edge0)
+				a0 = mid;
+			else
+				a1 = mid;
+		}
+		angles[num_rays++] = 0.5f * (a0 + a1);
+	}
+	qsort(angles, num_rays, sizeof(float), compare_float);
+
+	// chords between rays cut inside the curve, push the curve out so they do not
+	float grow = 1.0f / cosf((float)M_PI / segments);
+
+	bool hidden = c.hidden;
+	int num_vertices = hidden ? num_rays * 2 : num_rays + 1;
+	int num_indices = hidden ? num_rays * 6 : num_rays * 3;
+
+	float* vertices = ohmd_alloc(ctx, sizeof(float) * 2 * num_vertices);
+	unsigned int* indices = ohmd_alloc(ctx, sizeof(unsigned int) * num_indices);
+	if(!vertices || !indices){
+		free(angles);
+		free(vertices);
+		free(indices);
+		return OHMD_S_UNKNOWN_ERROR;
+	}
+
+	for(int i = 0; i < num_rays; i++){
+		float dx = cosf(angles[i]), dy = sinf(angles[i]);
+		float edge, boundary;
+		area_ray(&c, angles[i], &edge, &boundary);
+
+		// the visible area may stick out of the viewport, clipping takes care of that
+		float inner = OHMD_MIN(boundary, edge) * grow;
+		if(hidden)
+			inner = OHMD_MIN(inner, edge);
+
+		// back to [0,1] texture and viewport coordinates
+		float* v = vertices + i * 2;
+		v[0] = (p->lens_center[0] + dx * inner * ws) / p->viewport_scale[0];
+		v[1] = (p->lens_center[1] + dy * inner * ws) / p->viewport_scale[1];
+
+		if(hidden){
+			float* o = vertices + (num_rays + i) * 2;
+			o[0] = (p->lens_center[0] + dx * edge * ws) / p->viewport_scale[0];
+			o[1] = (p->lens_center[1] + dy * edge * ws) / p->viewport_scale[1];
+		}
+	}
+
+	unsigned int* idx = indices;
+	for(int i = 0; i < num_rays; i++){
+		unsigned int next = (i + 1) % num_rays;
+
+		if(hidden){
+			// band between the visible curve and the rectangle edge
+			*idx++ = i;
+			*idx++ = num_rays + i;
+			*idx++ = next;
+			*idx++ = next;
+			*idx++ = num_rays + i;
+			*idx++ = num_rays + next;
+		} else {
+			// fan around the lens center, stored last
+			*idx++ = num_rays;
+			*idx++ = i;
+			*idx++ = next;
+		}
+	}
+
+	if(!hidden){
+		vertices[num_rays * 2 + 0] = p->lens_center[0] / p->viewport_scale[0];
+		vertices[num_rays * 2 + 1] = p->lens_center[1] / p->viewport_scale[1];
+	}
+
+	free(angles);
+	odistortion_area_free(me);
+
+	me->vertices = vertices;
+	me->indices = indices;
+	me->num_vertices = num_vertices;
+	me->num_indices = num_indices;
+	me->segments = segments;
+	me->params = *p;
+	me->valid = true;
+
+	return OHMD_S_OK;
+}
+
+// derivative of the warp factor over the normalized radius
+static float warp_factor_deriv(const distortion_params* p, float r)
+{
+	return p->warp_param[2] + r * (2.0f * p->warp_param[1] + r * 3.0f * p->warp_param[0]);
+}
+
+/*
+ * Texture positions rho are reached from screen radius r as rho = r * K(r) * g.
+ * Along the radius a texel step covers 1 / (g * (K + r * K')) screen steps and
+ * across it 1 / (g * K), against 1 / (g * K(0)) at the lens center. The ratio
+ * projected on each texture axis is the density the screen needs there.
+ */
+static void needed_density(const area_ctx* c, float x, float y, float* out_x, float* out_y)
+{
+	const distortion_params* p = c->p;
+	float rho = sqrtf(x * x + y * y);
+	float k0 = fabsf(p->warp_param[3]);
+
+	if(rho < 1e-6f){
+		*out_x = *out_y = 1.0f;
+		return;
+	}
+
+	float a = atan2f(y, x), edge, boundary;
+	area_ray(c, a, &edge, &boundary);
+
+	float g = c->green_aberr;
+	if(rho > fabsf(edge * warp_factor(p, edge)) * g){
+		// beyond what the screen edge samples
+		*out_x = *out_y = 0;
+		return;
+	}
+
+	// back to the screen radius, the warp grows monotonically with the radius
+	float lo = 0, hi = edge;
+	for(int i = 0; i < 24; i++){
+		float mid = 0.5f * (lo + hi);
+		if(mid * fabsf(warp_factor(p, mid)) * g < rho)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	float r = 0.5f * (lo + hi);
+
+	float k_tan = fabsf(warp_factor(p, r));
+	float k_rad = fabsf(warp_factor(p, r) + r * warp_factor_deriv(p, r));
+	k_tan = OHMD_MAX(k_tan, 1e-6f);
+	k_rad = OHMD_MAX(k_rad, 1e-6f);
+
+	float cs = x / rho, sn = y / rho;
+	*out_x = k0 * sqrtf(POW2(cs / k_rad) + POW2(sn / k_tan));
+	*out_y = k0 * sqrtf(POW2(sn / k_rad) + POW2(cs / k_tan));
+}
+
+// coarsest of 1, 2 and 4 not dropping below the needed density
+static int rate_log2(float density)
+{
+	if(density * 4.0f <= 1.0f)
+		return 2;
+	if(density * 2.0f <= 1.0f)
+		return 1;
+	return 0;
+}
+
+ohmd_status odistortion_shading_rate_map(ohmd_context* ctx, const distortion_params* p, int width, int height, float quality, unsigned char* out)
+{
+	if(width < 1 || width > MAX_MAP_SIZE || height < 1 || height > MAX_MAP_SIZE || !out){
+		ohmd_set_error(ctx, "invalid shading rate map size: %dx%d", width, height);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	if(!(quality > 0 && quality <= 1)){
+		ohmd_set_error(ctx, "invalid shading rate quality: %f", quality);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	const float ws = p->warp_scale;
+	area_ctx c;
+	memset(&c, 0, sizeof(c));
+	c.p = p;
+	c.x0 = -p->lens_center[0] / ws;
+	c.x1 = (p->viewport_scale[0] - p->lens_center[0]) / ws;
+	c.y0 = -p->lens_center[1] / ws;
+	c.y1 = (p->viewport_scale[1] - p->lens_center[1]) / ws;
+	c.green_aberr = fabsf(p->aberr[1]);
+	c.hidden = true;
+
+	for(int ty = 0; ty < height; ty++){
+		for(int tx = 0; tx < width; tx++){
+			// the density changes smoothly, a 3x3 grid over the tile catches its maximum
+			float max_x = 0, max_y = 0;
+			for(int sy = 0; sy < 3; sy++){
+				for(int sx = 0; sx < 3; sx++){
+					float u = (tx + sx * 0.5f) / width, v = (ty + sy * 0.5f) / height;
+					float dx, dy;
+					needed_density(&c, (u * p->viewport_scale[0] - p->lens_center[0]) / ws,
+						(v * p->viewport_scale[1] - p->lens_center[1]) / ws, &dx, &dy);
+					max_x = OHMD_MAX(max_x, dx);
+					max_y = OHMD_MAX(max_y, dy);
+				}
+			}
+
+			int rx = rate_log2(max_x * quality);
+			int ry = rate_log2(max_y * quality);
+
+			// 1x4 and 4x1 are not valid rates
+			if(rx == 2 && ry == 0) rx = 1;
+			if(ry == 2 && rx == 0) ry = 1;
+
+			out[ty * width + tx] = (unsigned char)((rx << 2) | ry);
+		}
+	}
+
+	return OHMD_S_OK;
+}
+
+typedef void (*band_fn)(const void* arg, int row_begin, int row_end, float* scratch);
+
+typedef struct {
+	band_fn fn;
+	const void* arg;
+	int row_begin, row_end;
+	float* scratch;
+} band_job;
+
+static unsigned int band_thread(void* arg)
+{
+	band_job* job = (band_job*)arg;
+	job->fn(job->arg, job->row_begin, job->row_end, job->scratch);
+	return 0;
+}
+
+// splits the rows into bands over up to MAX_BAND_THREADS threads, each band gets scratch_len floats
+static ohmd_status run_bands(ohmd_context* ctx, band_fn fn, const void* arg, int rows, int row_len, int scratch_len)
+{
+	int num_jobs = (rows * row_len) / TEXELS_PER_THREAD;
+	num_jobs = OHMD_MAX(1, OHMD_MIN(num_jobs, MAX_BAND_THREADS));
+	num_jobs = OHMD_MIN(num_jobs, rows);
+
+	band_job jobs[MAX_BAND_THREADS];
+	ohmd_thread* threads[MAX_BAND_THREADS] = { NULL };
+
+	float* scratch = ohmd_alloc(ctx, sizeof(float) * scratch_len * num_jobs);
+	if(!scratch)
+		return OHMD_S_UNKNOWN_ERROR;
+
+	for(int i = 0; i < num_jobs; i++){
+		jobs[i].fn = fn;
+		jobs[i].arg = arg;
+		jobs[i].row_begin = rows * i / num_jobs;
+		jobs[i].row_end = rows * (i + 1) / num_jobs;
+		jobs[i].scratch = scratch + scratch_len * i;
+	}
+
+	// the calling thread takes the first band, bands without a thread are done inline
+	for(int i = 1; i < num_jobs; i++)
+		threads[i] = ohmd_create_thread(ctx, band_thread, &jobs[i]);
+
+	band_thread(&jobs[0]);
+
+	for(int i = 1; i < num_jobs; i++){
+		if(threads[i])
+			ohmd_destroy_thread(threads[i]);
+		else
+			band_thread(&jobs[i]);
+	}
+
+	free(scratch);
+
+	return OHMD_S_OK;
+}
+
+typedef struct {
+	const distortion_params* p;
+	int width, height;
+	ohmd_distortion_map_format format;
+	void* out;
+} bake_job;
+
+static uint16_t float_to_half(float f)
+{
+	uint32_t x;
+	memcpy(&x, &f, sizeof(x));
+
+	uint32_t sign = (x >> 16) & 0x8000;
+	int32_t exp = (int32_t)((x >> 23) & 0xff) - 127 + 15;
+	uint32_t mant = x & 0x7fffff;
+
+	// denormals are flushed, they are far below a texel anyway
+	if(exp <= 0)
+		return sign;
+	if(exp >= 31)
+		return sign | 0x7c00;
+
+	// round to nearest, a carry into the exponent is still correct
+	uint32_t h = sign | (exp << 10) | (mant >> 13);
+	if(mant & 0x1000)
+		h++;
+
+	return h;
+}
+
+static uint16_t float_to_unorm16(float f)
+{
+	float n = (f - UNORM16_OFFSET) / UNORM16_SCALE;
+	n = n < 0 ? 0 : (n > 1 ? 1 : n);
+	return (uint16_t)(n * 65535.0f + 0.5f);
+}
+
+// scratch holds one row of green coordinates
+static void bake_rows(const void* arg, int row_begin, int row_end, float* scratch)
+{
+	const bake_job* job = (const bake_job*)arg;
+	const int w = job->width;
+	const float du = 1.0f / w;
+
+	for(int y = row_begin; y < row_end; y++){
+		float v = (y + 0.5f) / job->height;
+
+		// only green is stored, red and blue are scaled from it around the lens center
+		if(job->format == OHMD_DISTORTION_MAP_FLOAT32){
+			odistortion_map_row_green(job->p, w, 0.5f * du, du, v, (float*)job->out + (size_t)y * w * 2);
+			continue;
+		}
+
+		odistortion_map_row_green(job->p, w, 0.5f * du, du, v, scratch);
+
+		uint16_t* row = (uint16_t*)job->out + (size_t)y * w * 2;
+		if(job->format == OHMD_DISTORTION_MAP_FLOAT16){
+			for(int x = 0; x < w * 2; x++)
+				row[x] = float_to_half(scratch[x]);
+		} else {
+			for(int x = 0; x < w * 2; x++)
+				row[x] = float_to_unorm16(scratch[x]);
+		}
+	}
+}
+
+ohmd_status odistortion_bake_map(ohmd_context* ctx, const distortion_params* p, int width, int height,
+	ohmd_distortion_map_format format, void* out, ohmd_distortion_map_info* info)
+{
+	if(width < 1 || width > MAX_MAP_SIZE || height < 1 || height > MAX_MAP_SIZE || !out){
+		ohmd_set_error(ctx, "invalid distortion map size: %dx%d", width, height);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	if(format != OHMD_DISTORTION_MAP_FLOAT32 && format != OHMD_DISTORTION_MAP_FLOAT16 && format != OHMD_DISTORTION_MAP_UNORM16){
+		ohmd_set_error(ctx, "invalid distortion map format: %d", format);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	bake_job job = { p, width, height, format, out };
+	ohmd_status ret = run_bands(ctx, bake_rows, &job, height, width, 2 * width);
+	if(ret != OHMD_S_OK)
+		return ret;
+
+	if(info){
+		float g = p->aberr[1] != 0 ? p->aberr[1] : 1.0f;
+
+		info->lens_center[0] = p->lens_center[0] / p->viewport_scale[0];
+		info->lens_center[1] = p->lens_center[1] / p->viewport_scale[1];
+		for(int i = 0; i < 3; i++)
+			info->aberr_ratio[i] = p->aberr[i] / g;
+
+		info->decode[0] = format == OHMD_DISTORTION_MAP_UNORM16 ? UNORM16_SCALE : 1.0f;
+		info->decode[1] = format == OHMD_DISTORTION_MAP_UNORM16 ? UNORM16_OFFSET : 0.0f;
+	}
+
+	return OHMD_S_OK;
+}
+
+typedef struct {
+	const distortion_params* params; // per eye
+	const ohmd_rgba_image* eyes[2];
+	ohmd_rgba_image* panel;
+} composite_job;
+
+// bilinear fetch of one channel with clamp to edge, texel centers at half texels and 8 bit weights like GPUs
+static unsigned char sample_channel(const ohmd_rgba_image* img, float u, float v, int channel)
+{
+	// coordinates are within or just outside [0,1] here, truncating instead of flooring is off by 1/256 texel at most
+	int x = (int)(u * img->width * 256.0f) - 128;
+	int y = (int)(v * img->height * 256.0f) - 128;
+	int fx = x & 255, fy = y & 255;
+
+	x >>= 8;
+	y >>= 8;
+
+	int x1 = OHMD_MIN(OHMD_MAX(x + 1, 0), img->width - 1);
+	int y1 = OHMD_MIN(OHMD_MAX(y + 1, 0), img->height - 1);
+	int x0 = OHMD_MIN(OHMD_MAX(x, 0), img->width - 1);
+	int y0 = OHMD_MIN(OHMD_MAX(y, 0), img->height - 1);
+
+	const unsigned char* r0 = img->pixels + (size_t)y0 * img->stride + channel;
+	const unsigned char* r1 = img->pixels + (size_t)y1 * img->stride + channel;
+
+	int top = r0[x0 * 4] * (256 - fx) + r0[x1 * 4] * fx;
+	int bottom = r1[x0 * 4] * (256 - fx) + r1[x1 * 4] * fx;
+
+	return (unsigned char)((top * (256 - fy) + bottom * fy + (1 << 15)) >> 16);
+}
+
+// scratch holds the red, green and blue coordinates of one eye row
+static void composite_rows(const void* arg, int row_begin, int row_end, float* scratch)
+{
+	const composite_job* job = (const composite_job*)arg;
+	ohmd_rgba_image* panel = job->panel;
+	const int eye_w = panel->width / 2;
+	const float du = 1.0f / eye_w;
+
+	for(int y = row_begin; y < row_end; y++){
+		float v = (y + 0.5f) / panel->height;
+		unsigned char* row = panel->pixels + (size_t)y * panel->stride;
+
+		for(int eye = 0; eye < 2; eye++){
+			const ohmd_rgba_image* src = job->eyes[eye];
+			unsigned char* out = row + eye * eye_w * 4;
+
+			odistortion_map_row(&job->params[eye], eye_w, 0.5f * du, du, v, scratch, 6);
+
+			for(int x = 0; x < eye_w; x++){
+				const float* tc = scratch + x * 6;
+
+				// black edges off the texture
+				if(tc[2] < 0 || tc[2] > 1 || tc[3] < 0 || tc[3] > 1){
+					out[x * 4 + 0] = out[x * 4 + 1] = out[x * 4 + 2] = 0;
+				} else {
+					out[x * 4 + 0] = sample_channel(src, tc[0], tc[1], 0);
+					out[x * 4 + 1] = sample_channel(src, tc[2], tc[3], 1);
+					out[x * 4 + 2] = sample_channel(src, tc[4], tc[5], 2);
+				}
+				out[x * 4 + 3] = 255;
+			}
+		}
+	}
+}
+
+static bool valid_image(const ohmd_rgba_image* img, int min_width)
+{
+	return img && img->pixels && img->width >= min_width && img->height >= 1 && img->stride >= img->width * 4;
+}
+
+ohmd_status odistortion_composite(ohmd_context* ctx, const distortion_params* params, const ohmd_rgba_image* left, const ohmd_rgba_image* right, ohmd_rgba_image* panel)
+{
+	if(!valid_image(left, 1) || !valid_image(right, 1) || !valid_image(panel, 2)){
+		ohmd_set_error(ctx, "invalid image passed to the compositor");
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	composite_job job = { params, { left, right }, panel };
+	return run_bands(ctx, composite_rows, &job, panel->height, panel->width, 6 * (panel->width / 2));
+}
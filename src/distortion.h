@@ -0,0 +1,65 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Lens Distortion */
+
+
+#ifndef DISTORTION_H
+#define DISTORTION_H
+
+#include <stdbool.h>
+#include "openhmd.h"
+#include "omath.h"
+
+// per eye inputs of the universal distortion shader, same names and units
+typedef struct {
+	float lens_center[2];    // m, from the lower left of the eye viewport
+	float viewport_scale[2]; // m, size of the eye viewport
+	float warp_scale;        // m, distance to the furthest viewport edge from the lens centers
+	float warp_param[4];     // PanoTools model [a,b,c,d]
+	float aberr[3];          // post warp per channel scaling [r,g,b]
+} distortion_params;
+
+typedef struct {
+	bool valid;
+	distortion_params params;
+	int grid_width, grid_height;
+	ohmd_distortion_vertex* vertices;
+	unsigned int* indices;
+} distortion_mesh;
+
+typedef struct {
+	bool valid;
+	distortion_params params;
+	int segments;
+	int num_vertices, num_indices;
+	float* vertices;
+	unsigned int* indices;
+} distortion_area;
+
+void odistortion_get_params(const ohmd_device* device, ohmd_eye eye, distortion_params* out);
+void odistortion_get_tangents(const ohmd_device* device, ohmd_eye eye, float* out);
+void odistortion_get_render_target_size(const ohmd_device* device, float density, int* width, int* height);
+void odistortion_timewarp_matrix(const float* tangents, const quatf* render_rotation, const quatf* display_rotation, float* out);
+void odistortion_map_row(const distortion_params* p, int count, float u0, float du, float v, float* out, int stride);
+void odistortion_map_row_green(const distortion_params* p, int count, float u0, float du, float v, float* out);
+void odistortion_distort_points(const distortion_params* p, int channel, int count, const float* in, float* out);
+void odistortion_undistort_points(const distortion_params* p, int channel, int count, const float* in, float* out);
+
+ohmd_status odistortion_mesh_update(ohmd_context* ctx, distortion_mesh* me, const distortion_params* p, int grid_width, int grid_height);
+void odistortion_mesh_free(distortion_mesh* me);
+
+ohmd_status odistortion_area_update(ohmd_context* ctx, distortion_area* me, const distortion_params* p, ohmd_area_mesh_type type, int segments);
+void odistortion_area_free(distortion_area* me);
+
+ohmd_status odistortion_shading_rate_map(ohmd_context* ctx, const distortion_params* p, int width, int height, float quality, unsigned char* out);
+
+ohmd_status odistortion_composite(ohmd_context* ctx, const distortion_params* params, const ohmd_rgba_image* left, const ohmd_rgba_image* right, ohmd_rgba_image* panel);
+
+ohmd_status odistortion_bake_map(ohmd_context* ctx, const distortion_params* p, int width, int height,
+	ohmd_distortion_map_format format, void* out, ohmd_distortion_map_info* info);
+
+#endif
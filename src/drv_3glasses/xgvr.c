@@ -258,7 +258,7 @@ static void _get_device_list(ohmd_driver* driver, ohmd_device_list* list)
             continue;
 
         while (cur_dev) {
-            ohmd_device_desc* desc = &list->devices[list->num_devices++];
+            ohmd_device_desc* desc = ohmd_device_list_add(list);
 
             strcpy(desc->driver, "OpenHMD 3Glasses Driver");
             strcpy(desc->vendor, "3Glasses");
@@ -231,7 +231,7 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 
 static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 {
-	ohmd_device_desc* desc = &list->devices[list->num_devices++];
+	ohmd_device_desc* desc = ohmd_device_list_add(list);
 
 	strcpy(desc->driver, "OpenHMD Generic Android Driver");
 	strcpy(desc->vendor, "OpenHMD");
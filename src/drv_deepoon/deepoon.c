@@ -261,6 +261,7 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 
 	// initialize sensor fusion
 	ofusion_init(&priv->sensor_fusion);
+	priv->base.fusion = &priv->sensor_fusion;
 
 	return &priv->base;
 
@@ -281,7 +282,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 		if (ohmd_wstring_match(cur_dev->manufacturer_string, L"DeePoon VR, Inc.") &&
 			ohmd_wstring_match(cur_dev->product_string, L"DeePoon Tracker Device")) {
 
-			ohmd_device_desc* desc = &list->devices[list->num_devices++];
+			ohmd_device_desc* desc = ohmd_device_list_add(list);
 
 			strcpy(desc->driver, "Deepoon Driver");
 			strcpy(desc->vendor, "Deepoon");
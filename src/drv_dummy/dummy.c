@@ -121,7 +121,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 
 	// HMD
 
-	desc = &list->devices[list->num_devices++];
+	desc = ohmd_device_list_add(list);
 
 	strcpy(desc->driver, "OpenHMD Null Driver");
 	strcpy(desc->vendor, "OpenHMD");
@@ -138,7 +138,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 
 	// Left Controller
 	
-	desc = &list->devices[list->num_devices++];
+	desc = ohmd_device_list_add(list);
 
 	strcpy(desc->driver, "OpenHMD Null Driver");
 	strcpy(desc->vendor, "OpenHMD");
@@ -159,7 +159,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 	
 	// Right Controller
 	
-	desc = &list->devices[list->num_devices++];
+	desc = ohmd_device_list_add(list);
 
 	strcpy(desc->driver, "OpenHMD Null Driver");
 	strcpy(desc->vendor, "OpenHMD");
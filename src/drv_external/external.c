@@ -9,16 +9,118 @@
 /* External Driver */
 
 
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "../openhmdi.h"
 #include "string.h"
 
+#ifndef _WIN32
+#include "openhmd_ring.h"
+
+#define RING_BATCH 64    // samples popped at a time
+#define RING_RETRY 1.0   // seconds between attempts to open a ring that isn't there (yet)
+#endif
+
 typedef struct {
 	ohmd_device base;
 	fusion sensor_fusion;
+
+	double last_sample_time; // valid if have_sample_time
+	bool have_sample_time;
+
+#ifndef _WIN32
+	char ring_name[OHMD_STR_SIZE]; // empty if not draining a ring
+	ohmd_ring ring;                // mapped if ring.header is set
+	double ring_retry_time;
+	uint32_t ring_dropped;         // producer overruns seen so far
+#endif
 } external_priv;
 
+static void push_sample(external_priv* priv, const ohmd_sensor_sample* s)
+{
+	float dt = s->dt;
+
+	if(s->time > 0){
+		// absolute timestamps give the step, the first one only starts the clock unless it has a dt
+		if(priv->have_sample_time){
+			dt = (float)(s->time - priv->last_sample_time);
+
+			// duplicates and samples out of order would integrate backwards
+			if(dt <= 0)
+				return;
+		}
+
+		priv->last_sample_time = s->time;
+		priv->have_sample_time = true;
+
+		if(dt <= 0)
+			return;
+
+		ofusion_set_sample_time(&priv->sensor_fusion, s->time);
+	}
+
+	ofusion_update(&priv->sensor_fusion, dt, (const vec3f*)s->gyro, (const vec3f*)s->accel, (const vec3f*)s->mag);
+}
+
+#ifndef _WIN32
+static void set_ring(external_priv* priv, const char* name)
+{
+	ohmd_ring_close(&priv->ring);
+	snprintf(priv->ring_name, OHMD_STR_SIZE, "%s", name ? name : "");
+	priv->ring_retry_time = 0;
+}
+
+static void drain_ring(external_priv* priv)
+{
+	if(!priv->ring_name[0])
+		return;
+
+	if(!priv->ring.header){
+		double now = ohmd_get_tick();
+		if(now < priv->ring_retry_time)
+			return;
+
+		if(ohmd_ring_open(&priv->ring, priv->ring_name) < 0){
+			priv->ring_retry_time = now + RING_RETRY;
+			return;
+		}
+
+		LOGI("draining sample ring %s", priv->ring_name);
+		priv->ring_dropped = __atomic_load_n(&priv->ring.header->dropped, __ATOMIC_RELAXED);
+	}
+
+	// at most one ring's worth, a producer that keeps up with us must not stall the update
+	ohmd_sensor_sample batch[RING_BATCH];
+	uint32_t total = 0;
+	int count = 0;
+
+	while(total < priv->ring.capacity && (count = ohmd_ring_pop(&priv->ring, batch, RING_BATCH)) > 0){
+		for(int i = 0; i < count; i++)
+			push_sample(priv, batch + i);
+		total += count;
+	}
+
+	if(count < 0){
+		LOGW("sample ring %s was replaced, reopening", priv->ring_name);
+		ohmd_ring_close(&priv->ring);
+		return;
+	}
+
+	uint32_t dropped = __atomic_load_n(&priv->ring.header->dropped, __ATOMIC_RELAXED);
+	if(dropped != priv->ring_dropped){
+		LOGW("sample ring %s overran, %u samples lost", priv->ring_name, dropped - priv->ring_dropped);
+		priv->ring_dropped = dropped;
+	}
+}
+#endif
+
 static void update_device(ohmd_device* device)
 {
+#ifndef _WIN32
+	drain_ring((external_priv*)device);
+#endif
 }
 
 static int getf(ohmd_device* device, ohmd_float_value type, float* out)
@@ -63,9 +165,47 @@ static int setf(ohmd_device* device, ohmd_float_value type, const float* in)
 	return 0;
 }
 
+static int set_data(ohmd_device* device, ohmd_data_value type, const void* in)
+{
+	external_priv* priv = (external_priv*)device;
+
+	switch(type){
+		case OHMD_EXTERNAL_SENSOR_SAMPLES: {
+				const ohmd_sensor_samples* batch = (const ohmd_sensor_samples*)in;
+				for(int i = 0; i < batch->count; i++)
+					push_sample(priv, batch->samples + i);
+			}
+			break;
+
+		case OHMD_EXTERNAL_SENSOR_RING:
+#ifndef _WIN32
+			set_ring(priv, (const char*)in);
+			drain_ring(priv);
+			if(priv->ring_name[0] && !priv->ring.header)
+				LOGW("no sample ring %s yet, retrying", priv->ring_name);
+			break;
+#else
+			ohmd_set_error(priv->base.ctx, "sample rings need POSIX shared memory");
+			return -1;
+#endif
+
+		default:
+			ohmd_set_error(priv->base.ctx, "invalid type given to set_data (%d)", type);
+			return -1;
+			break;
+	}
+
+	return 0;
+}
+
 static void close_device(ohmd_device* device)
 {
 	LOGD("closing external device");
+
+#ifndef _WIN32
+	ohmd_ring_close(&((external_priv*)device)->ring);
+#endif
+
 	free(device);
 }
 
@@ -98,15 +238,21 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 	priv->base.close = close_device;
 	priv->base.getf = getf;
 	priv->base.setf = setf;
+	priv->base.set_data = set_data;
 	
 	ofusion_init(&priv->sensor_fusion);
+	priv->base.fusion = &priv->sensor_fusion;
+
+#ifndef _WIN32
+	set_ring(priv, getenv(OHMD_RING_NAME_ENV));
+#endif
 
 	return (ohmd_device*)priv;
 }
 
 static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 {
-	ohmd_device_desc* desc = &list->devices[list->num_devices++];
+	ohmd_device_desc* desc = ohmd_device_list_add(list);
 
 	strcpy(desc->driver, "OpenHMD Generic External Driver");
 	strcpy(desc->vendor, "OpenHMD");
@@ -43,6 +43,7 @@ typedef struct {
 	hid_device* hmd_handle;
 	hid_device* imu_handle;
 	fusion sensor_fusion;
+	clock_sync imu_clock;
 	vec3f raw_accel, raw_gyro;
 	uint32_t last_ticks;
 	uint8_t last_seq;
@@ -78,6 +79,10 @@ static void vec3f_from_vive_vec_gyro(const vive_imu_config* config,
 
 static bool process_error(vive_priv* priv)
 {
+	// the kalman filter estimates the gyro bias online, no need to sit still at startup
+	if(priv->sensor_fusion.engine == FUSION_ENGINE_ESKF)
+		return true;
+
 	if(priv->gyro_q.at >= priv->gyro_q.size - 1)
 		return true;
 
@@ -129,6 +134,7 @@ static void handle_imu_packet(vive_priv* priv, unsigned char *buffer, int size)
 	vive_decode_sensor_packet(&pkt, buffer, size);
 
 	vive_headset_imu_sample* smp = NULL;
+	double now = ohmd_get_tick();
 
 	while((smp = get_next_sample(&pkt, priv->last_seq)) != NULL)
 	{
@@ -169,6 +175,8 @@ static void handle_imu_packet(vive_priv* priv, unsigned char *buffer, int size)
 			vec3f gyro;
 			ovec3f_subtract(&priv->raw_gyro, &priv->gyro_error, &gyro);
 
+			ofusion_set_sample_time(&priv->sensor_fusion,
+				oclock_sync_update(&priv->imu_clock, smp->time_ticks, now));
 			ofusion_update(&priv->sensor_fusion, dt,
 			               &gyro, &priv->raw_accel, &mag);
 		}
@@ -652,6 +660,8 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 	priv->base.getf = getf;
 
 	ofusion_init(&priv->sensor_fusion);
+	priv->base.fusion = &priv->sensor_fusion;
+	oclock_sync_init(&priv->imu_clock, VIVE_CLOCK_FREQ, 32);
 
 	ofq_init(&priv->gyro_q, 128);
 
@@ -681,7 +691,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 
 	int idx = 0;
 	while (cur_dev) {
-		ohmd_device_desc* desc = &list->devices[list->num_devices++];
+		ohmd_device_desc* desc = ohmd_device_list_add(list);
 
 		strcpy(desc->driver, "OpenHMD HTC Vive Driver");
 		strcpy(desc->vendor, "HTC/Valve");
@@ -19,6 +19,8 @@
 #include "../hid.h"
 
 #define TICK_LEN (1.0f / 120000.0f) // 120 Hz ticks
+#define POSITION_VARIANCE 1e-5f // base station position noise, ~3 mm
+#define MAX_POSITION_PREDICTION 0.05 // seconds, the reports come in at 120 Hz
 
 static const int controllerLength = 3 + (3+4)*2 + 2 + 2 + 1;
 static devices_t* nolo_devices;
@@ -42,6 +44,13 @@ static void gyro_from_nolo_vec(const int16_t* smp, vec3f* out_vec)
 	out_vec->z = -(float)smp[2];
 }
 
+// queues the control changes as soon as a report is decoded
+static void decode_controller(drv_priv* priv, unsigned char* buffer)
+{
+	nolo_decode_controller(priv, buffer);
+	ohmd_device_report_controls(&priv->base, 0, ohmd_get_tick());
+}
+
 static void handle_tracker_sensor_msg(drv_priv* priv, unsigned char* buffer, int size, int type)
 {
 	uint64_t last_sample_tick = priv->sample.tick;
@@ -49,7 +58,7 @@ static void handle_tracker_sensor_msg(drv_priv* priv, unsigned char* buffer, int
 	//Type 0 is Head Tracker, type 1 is Controller
 	switch(type) {
 		case 0: nolo_decode_hmd_marker(priv, buffer); break;
-		case 1: nolo_decode_controller(priv, buffer); break;
+		case 1: decode_controller(priv, buffer); break;
 	}
 	
 	priv->sample.tick = ohmd_monotonic_get(priv->base.ctx);
@@ -65,6 +74,29 @@ static void handle_tracker_sensor_msg(drv_priv* priv, unsigned char* buffer, int
 	accel_from_nolo_vec(priv->sample.accel, &priv->raw_gyro);
 	gyro_from_nolo_vec(priv->sample.gyro, &priv->raw_accel);
 	ofusion_update(&priv->sensor_fusion, dt, &priv->raw_gyro, &priv->raw_accel, &mag);
+
+	// FIXME: the accelerometer scale is unknown, assume the long term magnitude is gravity
+	float norm = ovec3f_get_length(&priv->raw_accel);
+	if(priv->accel_norm == 0)
+		priv->accel_norm = norm;
+	else
+		priv->accel_norm += (norm - priv->accel_norm) * 0.001f;
+
+	// the fusion dt above is kept as is since the gyro is unscaled as well
+	float pos_dt = tick_delta / (float)priv->base.ctx->monotonic_ticks_per_sec;
+
+	if(priv->accel_norm > 0){
+		float scale = priv->pos_filter.gravity / priv->accel_norm;
+		vec3f accel = {{ priv->raw_accel.x * scale, priv->raw_accel.y * scale, priv->raw_accel.z * scale }};
+		oposition_filter_predict_imu(&priv->pos_filter, pos_dt, &priv->sensor_fusion.orient, &accel);
+	}
+
+	if(priv->raw_position_new){
+		oposition_filter_correct(&priv->pos_filter, &priv->raw_position, POSITION_VARIANCE);
+		priv->raw_position_new = false;
+	}
+
+	priv->pos_filter_time = ohmd_get_tick();
 }
 
 static void update_device(ohmd_device* device)
@@ -110,9 +142,9 @@ static void update_device(ohmd_device* device)
 			case NOLO_LEGACY_CONTROLLER_TRACKER: // Controllers packet
 			{
 				if (controller0)
-					nolo_decode_controller(controller0, buffer+1);
+					decode_controller(controller0, buffer+1);
 				if (controller1)
-					nolo_decode_controller(controller1, buffer+64-controllerLength);
+					decode_controller(controller1, buffer+64-controllerLength);
 			break;
 			}
 			case NOLO_LEGACY_HMD_TRACKER: // HMD packet
@@ -157,17 +189,11 @@ static int getf(ohmd_device* device, ohmd_float_value type, float* out)
 		}
 
 	case OHMD_POSITION_VECTOR:
-		if(priv->id == 0) {
-			// HMD
-			*(vec3f*)out = priv->base.position;
-		}
-		else if(priv->id == 1) {
-			// Controller 0
-			*(vec3f*)out = priv->base.position;
-		}
-		else if(priv->id == 2) {
-			// Controller 1
-			*(vec3f*)out = priv->base.position;
+		if (priv->rev == 1 || !priv->pos_filter.valid) //old firmware has no IMU to filter with
+			*(vec3f*)out = priv->raw_position;
+		else { //new firmware, extrapolate from the last sample to now
+			float ahead = (float)OHMD_MIN(OHMD_MAX(ohmd_get_tick() - priv->pos_filter_time, 0.0), MAX_POSITION_PREDICTION);
+			oposition_filter_get_predicted(&priv->pos_filter, ahead, (vec3f*)out);
 		}
 		break;
 
@@ -274,6 +300,7 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 	else if (priv->id == 1) {
 		mNOLO->controller0 = priv;
 		priv->base.properties.control_count = 8;
+		priv->base.reports_controls = true;
 		priv->base.properties.controls_hints[0] = OHMD_ANALOG_PRESS;
 		priv->base.properties.controls_hints[1] = OHMD_TRIGGER_CLICK;
 		priv->base.properties.controls_hints[2] = OHMD_MENU;
@@ -294,6 +321,7 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 	else if (priv->id == 2) {
 		mNOLO->controller1 = priv;
 		priv->base.properties.control_count = 8;
+		priv->base.reports_controls = true;
 		priv->base.properties.controls_hints[0] = OHMD_ANALOG_PRESS;
 		priv->base.properties.controls_hints[1] = OHMD_TRIGGER_CLICK;
 		priv->base.properties.controls_hints[2] = OHMD_MENU;
@@ -321,6 +349,8 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 	priv->base.getf = getf;
 
 	ofusion_init(&priv->sensor_fusion);
+	priv->base.fusion = &priv->sensor_fusion;
+	oposition_filter_init(&priv->pos_filter);
 
 	return &priv->base;
 
@@ -367,7 +397,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 
 		int id = 0;
 		while (cur_dev && is_nolo_device(cur_dev)) {
-			ohmd_device_desc* desc = &list->devices[list->num_devices++];
+			ohmd_device_desc* desc = ohmd_device_list_add(list);
 
 			strcpy(desc->driver, "OpenHMD NOLO VR CV1 driver");
 			strcpy(desc->vendor, "LYRobotix");
@@ -384,7 +414,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 			desc->id = id++;
 
 			//Controller 0
-			desc = &list->devices[list->num_devices++];
+			desc = ohmd_device_list_add(list);
 
 			strcpy(desc->driver, "OpenHMD NOLO VR CV1 driver");
 			strcpy(desc->vendor, "LYRobotix");
@@ -403,7 +433,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 			desc->id = id++;
 
 			// Controller 1
-			desc = &list->devices[list->num_devices++];
+			desc = ohmd_device_list_add(list);
 
 			strcpy(desc->driver, "OpenHMD NOLO VR CV1 driver");
 			strcpy(desc->vendor, "LYRobotix");
@@ -34,6 +34,12 @@ typedef struct {
 	nolo_sample sample;
 	fusion sensor_fusion;
 	vec3f raw_accel, raw_gyro;
+
+	vec3f raw_position; // last base station position
+	bool raw_position_new;
+	position_filter pos_filter;
+	double pos_filter_time; // host time of the last filter step
+	float accel_norm; // low passed magnitude of raw_accel, used to find the unknown scale
 } drv_priv;
 
 typedef enum
@@ -191,7 +191,8 @@ void nolo_decode_controller(drv_priv* priv, const unsigned char* data)
 		priv->sample = smp; //Set sample for fusion
 	}
 
-	priv->base.position = position;
+	priv->raw_position = position;
+	priv->raw_position_new = true;
 }
 
 void nolo_decode_hmd_marker(drv_priv* priv, const unsigned char* data)
@@ -220,7 +221,8 @@ void nolo_decode_hmd_marker(drv_priv* priv, const unsigned char* data)
 		priv->sample = smp; //Set sample for fusion
 	}
 
-	priv->base.position = position;
+	priv->raw_position = position;
+	priv->raw_position_new = true;
 }
 
 void nolo_decode_base_station(drv_priv* priv, const unsigned char* data)
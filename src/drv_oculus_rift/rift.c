@@ -47,6 +47,7 @@ struct rift_hmd_s {
 	uint32_t last_imu_timestamp;
 	double last_keep_alive;
 	fusion sensor_fusion;
+	clock_sync imu_clock;
 	vec3f raw_mag, raw_accel, raw_gyro;
 
 	struct {
@@ -224,10 +225,15 @@ static void handle_tracker_sensor_msg(rift_hmd_t* priv, unsigned char* buffer, i
 		dt -= (s->num_samples - 1) * TICK_LEN; // TODO: query the Rift for the sample rate
 	}
 
+	// the report timestamp is that of the last sample
+	oclock_sync_update(&priv->imu_clock, s->timestamp, ohmd_get_tick());
+
 	for(int i = 0; i < s->num_samples; i++){
 		vec3f_from_rift_vec(s->samples[i].accel, &priv->raw_accel);
 		vec3f_from_rift_vec(s->samples[i].gyro, &priv->raw_gyro);
 
+		uint32_t sample_ts = s->timestamp - (s->num_samples - 1 - i) * 1000; // TICK_LEN in us
+		ofusion_set_sample_time(&priv->sensor_fusion, oclock_sync_to_host(&priv->imu_clock, sample_ts));
 		ofusion_update(&priv->sensor_fusion, dt, &priv->raw_gyro, &priv->raw_accel, &priv->raw_mag);
 		dt = TICK_LEN; // TODO: query the Rift for the sample rate
 	}
@@ -310,6 +316,8 @@ static void handle_touch_controller_message(rift_hmd_t *hmd,
 			  c->gyro_calibration[7] * g[1] +
 			  c->gyro_calibration[8] * g[2];
 
+	ofusion_set_sample_time(&touch->imu_fusion,
+		oclock_sync_update(&touch->imu_clock, msg->touch.timestamp, ohmd_get_tick()));
 	ofusion_update(&touch->imu_fusion, dt_s, &gyro, &accel, &mag);
 	touch->last_timestamp = msg->touch.timestamp;
 	touch->time_valid = true;
@@ -389,12 +397,15 @@ static void handle_rift_radio_message(rift_hmd_t *hmd, pkt_rift_radio_message *m
 				LOGV ("Remote buttons state 0x%02x", msg->remote.buttons);
 			}
 			hmd->remote_buttons_state = msg->remote.buttons;
+			ohmd_device_report_controls (&hmd->hmd_dev.base, 0, ohmd_get_tick());
 			break;
 		case RIFT_TOUCH_CONTROLLER_RIGHT:
 			handle_touch_controller_message (hmd, &hmd->touch_dev[0], msg);
+			ohmd_device_report_controls (&hmd->touch_dev[0].base.base, msg->touch.timestamp / 1000000.0, ohmd_get_tick());
 			break;
 		case RIFT_TOUCH_CONTROLLER_LEFT:
 			handle_touch_controller_message (hmd, &hmd->touch_dev[1], msg);
+			ohmd_device_report_controls (&hmd->touch_dev[1].base.base, msg->touch.timestamp / 1000000.0, ohmd_get_tick());
 			break;
 	}
 }
@@ -732,11 +743,14 @@ static void init_touch_device(rift_touch_controller_t *touch, int id, int device
 
 	touch->device_num = device_num;
 	ofusion_init(&touch->imu_fusion);
+	ohmd_dev->fusion = &touch->imu_fusion;
+	oclock_sync_init(&touch->imu_clock, 1000000.0, 32);
 	touch->time_valid = false;
 
 	ohmd_set_default_device_properties(&ohmd_dev->properties);
 
 	ohmd_dev->properties.control_count = 8;
+	ohmd_dev->reports_controls = true;
 
 	if (id == 0) {
 		ohmd_dev->properties.controls_hints[0] = OHMD_BUTTON_A;
@@ -891,6 +905,7 @@ static rift_hmd_t *open_hmd(ohmd_driver* driver, ohmd_device_desc* desc)
 	if (desc->revision == REV_CV1) {
 		/* On the CV1, add some control mappings for the simple Oculus remote control buttons */
 		hmd_dev->base.properties.control_count = 9;
+		hmd_dev->base.reports_controls = true;
 		hmd_dev->base.properties.controls_hints[0] = OHMD_BUTTON_Y; // UP
 		hmd_dev->base.properties.controls_hints[1] = OHMD_BUTTON_A; // DOWN
 		hmd_dev->base.properties.controls_hints[2] = OHMD_BUTTON_X; // LEFT
@@ -966,6 +981,8 @@ static rift_hmd_t *open_hmd(ohmd_driver* driver, ohmd_device_desc* desc)
 
 	// initialize sensor fusion
 	ofusion_init(&priv->sensor_fusion);
+	hmd_dev->base.fusion = &priv->sensor_fusion;
+	oclock_sync_init(&priv->imu_clock, 1000000.0, 32);
 
 	return priv;
 
@@ -1084,7 +1101,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 			if(ohmd_wstring_match(cur_dev->manufacturer_string, L"Oculus VR, Inc.") &&
 			   (rd[i].iface == -1 || cur_dev->interface_number == rd[i].iface)) {
 				int id = 0;
-				ohmd_device_desc* desc = &list->devices[list->num_devices++];
+				ohmd_device_desc* desc = ohmd_device_list_add(list);
 
 				strcpy(desc->driver, "OpenHMD Rift Driver");
 				strcpy(desc->vendor, "Oculus VR, Inc.");
@@ -1103,7 +1120,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 				/* For CV1, publish touch controllers */
 				if (desc->revision == REV_CV1) {
 					//Controller 0 (right)
-					desc = &list->devices[list->num_devices++];
+					desc = ohmd_device_list_add(list);
 					desc->revision = rd[i].rev;
 
 					strcpy(desc->driver, "OpenHMD Rift Driver");
@@ -1122,7 +1139,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 					desc->id = id++;
 
 					// Controller 1 (left)
-					desc = &list->devices[list->num_devices++];
+					desc = ohmd_device_list_add(list);
 					desc->revision = rd[i].rev;
 
 					strcpy(desc->driver, "OpenHMD Rift Driver");
@@ -214,6 +214,7 @@ struct rift_touch_controller_s {
 
 	int device_num;
 	fusion imu_fusion;
+	clock_sync imu_clock;
 
 	bool have_calibration;
 	rift_touch_calibration calibration;
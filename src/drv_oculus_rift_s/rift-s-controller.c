@@ -25,7 +25,9 @@ update_device_types (rift_s_hmd_t *hmd, hid_device *hid) {
 	int res;
 	rift_s_devices_list_t dev_list;
 
+	rift_s_hmd_lock_handle (hmd);
 	res = rift_s_read_devices_list (hid, &dev_list);
+	rift_s_hmd_unlock_handle (hmd);
 	if (res < 0)
 		return res;
 
@@ -147,6 +149,8 @@ handle_imu_update (rift_s_controller_state *ctrl, uint32_t imu_timestamp, const
 	vec3f_rotate_3x3(&ctrl->accel, ctrl->calibration.accel.rectification);
 	vec3f_rotate_3x3(&ctrl->gyro, ctrl->calibration.gyro.rectification);
 
+	ofusion_set_sample_time(&ctrl->imu_fusion,
+		oclock_sync_update(&ctrl->imu_clock, imu_timestamp, ohmd_get_tick()));
 	ofusion_update(&ctrl->imu_fusion, dt_sec, &ctrl->gyro, &ctrl->accel, &ctrl->mag);
 #if 0
 	printf ("dt = %f raw accel %d %d %d gyro %d %d %d -> accel %f %f %f  gyro %f %f %f\n",
@@ -347,7 +351,7 @@ get_controller_configuration (rift_s_hmd_t *hmd, rift_s_controller_state *ctrl)
 }
 
 void
-rift_s_handle_controller_report (rift_s_hmd_t *hmd, hid_device *hid, const unsigned char *buf, int size)
+rift_s_handle_controller_report (rift_s_hmd_t *hmd, hid_device *hid, const unsigned char *buf, int size, double now)
 {
 	rift_s_controller_report_t report;
 
@@ -384,6 +388,9 @@ rift_s_handle_controller_report (rift_s_hmd_t *hmd, hid_device *hid, const unsig
 		memset (ctrl, 0, sizeof (rift_s_controller_state));
 		ctrl->device_id = report.device_id;
 		ofusion_init(&ctrl->imu_fusion);
+		/* Controllers come and go, so they follow the engine selected for the HMD */
+		ofusion_set_engine(&ctrl->imu_fusion, hmd->sensor_fusion.engine);
+		oclock_sync_init(&ctrl->imu_clock, 1000000.0, 32);
 
 		update_device_types (hmd, hid);
 		get_controller_configuration (hmd, ctrl);
@@ -393,6 +400,16 @@ rift_s_handle_controller_report (rift_s_hmd_t *hmd, hid_device *hid, const unsig
 	if (ctrl->device_type == 0x00)
 		update_device_types (hmd, hid);
 
-	if (!update_controller_state (ctrl, &report))
+	if (!update_controller_state (ctrl, &report)) {
 		rift_s_hexdump_buffer ("Invalid Controller Report Content", buf, size);
+		return;
+	}
+
+	/* Queue the control changes on the device this controller is exposed as */
+	for (i = 0; i < MAX_CONTROLLERS; i++) {
+		if (hmd->touch_dev[i].device_num == ctrl - hmd->controllers) {
+			double device_time = ctrl->imu_time_valid ? ctrl->imu_timestamp / 1000000.0 : 0;
+			ohmd_device_report_controls (&hmd->touch_dev[i].base.base, device_time, now);
+		}
+	}
 }
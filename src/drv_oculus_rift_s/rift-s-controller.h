@@ -68,8 +68,9 @@ typedef struct {
   vec3f gyro;
   vec3f mag;
 	fusion imu_fusion;
+	clock_sync imu_clock;
 } rift_s_controller_state;
 
-void rift_s_handle_controller_report (rift_s_hmd_t *hmd, hid_device *hid, const unsigned char *buf, int size);
+void rift_s_handle_controller_report (rift_s_hmd_t *hmd, hid_device *hid, const unsigned char *buf, int size, double now);
 
 #endif
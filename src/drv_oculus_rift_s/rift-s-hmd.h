@@ -22,6 +22,23 @@
 
 #define MAX_CONTROLLERS 2
 
+/* A report as read by one of the reader threads */
+typedef struct {
+	double time; /* Host time it arrived */
+	int size;
+	unsigned char buf[FEATURE_BUFFER_SIZE];
+} rift_s_queued_report;
+
+/* Reads one HID interface on its own thread, see OHMD_RIFT_S_READER_THREADS */
+typedef struct {
+	rift_s_hmd_t *hmd;
+	hid_device *handle;
+	ohmd_thread *thread;
+	ohmd_mutex *lock; /* Held while reading if the update thread writes to the handle too */
+	spsc_queue queue;
+	uint32_t last_dropped;
+} rift_s_reader;
+
 struct rift_s_hmd_s {
 	ohmd_context* ctx;
 	int use_count;
@@ -31,6 +48,7 @@ struct rift_s_hmd_s {
 	uint32_t last_imu_timestamp;
 	double last_keep_alive;
 	fusion sensor_fusion;
+	clock_sync imu_clock;
 	vec3f raw_mag, raw_accel, raw_gyro;
 	float temperature;
 
@@ -47,9 +65,21 @@ struct rift_s_hmd_s {
 	/* Radio comms manager */
   rift_s_radio_state radio_state;
 
+	/* Reader threads, in the order of the handles */
+	bool use_readers;
+	volatile uint32_t readers_quit;
+	rift_s_reader readers[3];
+
+	/* The HMD interface carries the feature reports, see rift_s_hmd_lock_handle */
+	ohmd_mutex *handle_lock;
+	volatile uint32_t handle_wanted;
+
 	/* OpenHMD output devices */
 	rift_s_device_priv hmd_dev;
 	rift_s_controller_device touch_dev[MAX_CONTROLLERS];
 };
 
+void rift_s_hmd_lock_handle(rift_s_hmd_t *hmd);
+void rift_s_hmd_unlock_handle(rift_s_hmd_t *hmd);
+
 #endif
@@ -28,6 +28,24 @@ struct rift_s_radio_command {
 		void *cb_data;
 };
 
+/* The current blocks are ~2-3KB, so this should be enough to read
+ * the JSON config: */
+#define MAX_JSON_LEN 4096
+
+typedef struct rift_s_radio_json_read_state {
+	rift_s_radio_state *state;
+	uint64_t device_id;
+	rift_s_radio_completion_fn cb;
+	void *cb_data;
+
+	uint32_t cur_offset;
+	uint16_t block_len; /* Expected length, from the header */
+
+	uint8_t data[MAX_JSON_LEN+1];
+	uint16_t data_len;
+
+} rift_s_radio_json_read_state;
+
 static int get_radio_response_report (hid_device *hid, rift_s_hmd_radio_response_t *radio_response)
 {
 	int ret;
@@ -96,7 +114,7 @@ rift_s_radio_update (rift_s_radio_state *state, hid_device *hid)
  		/* Call the completion callback */
  		if (cmd->cb)
  			cmd->cb (true, radio_response.response_bytes, ret - 3, cmd->cb_data);
- 		free(cmd);
+ 		omem_pool_free(&state->commands, cmd);
  		read_another = true;
 
 	} while (read_another);
@@ -109,6 +127,12 @@ void rift_s_radio_state_init (rift_s_radio_state *state, ohmd_context *ctx)
 	state->pending_commands = NULL;
 	state->pending_commands_tail = NULL;
 	state->last_radio_seqnum = -1;
+
+	/* Enough for the config and JSON reads of both controllers */
+	omem_pool_init(&state->commands, ctx, sizeof(rift_s_radio_command), 16);
+	omem_pool_init(&state->json_reads, ctx, sizeof(rift_s_radio_json_read_state), 2);
+	omem_pool_reserve(&state->commands, 16);
+	omem_pool_reserve(&state->json_reads, 2);
 }
 
 void rift_s_radio_state_clear (rift_s_radio_state *state)
@@ -121,17 +145,25 @@ void rift_s_radio_state_clear (rift_s_radio_state *state)
 
 		if (prev->cb)
 				prev->cb (false, NULL, 0, prev->cb_data);
-		free(prev);
+		omem_pool_free(&state->commands, prev);
 	}
 
 	state->pending_commands = state->pending_commands_tail = NULL;
+
+	omem_pool_destroy(&state->commands);
+	omem_pool_destroy(&state->json_reads);
 }
 
 void rift_s_radio_queue_command (rift_s_radio_state *state, const uint64_t device_id,
 	const uint8_t *cmd_bytes, const int cmd_bytes_len,
 	rift_s_radio_completion_fn cb, void *cb_data)
 {
-	rift_s_radio_command *cmd = ohmd_alloc(state->ctx, sizeof(rift_s_radio_command));
+	rift_s_radio_command *cmd = omem_pool_alloc(&state->commands);
+	if (cmd == NULL) {
+		if (cb)
+			cb (false, NULL, 0, cb_data);
+		return;
+	}
 
 	assert (cmd_bytes_len <= sizeof (cmd->read_command.cmd_bytes));
 
@@ -153,23 +185,6 @@ void rift_s_radio_queue_command (rift_s_radio_state *state, const uint64_t devic
 	}
 }
 
-/* The current blocks are ~2-3KB, so this should be enough to read
- * the JSON config: */
-#define MAX_JSON_LEN 4096
-
-typedef struct rift_s_radio_json_read_state {
-	rift_s_radio_state *state;
-	uint64_t device_id;
-	rift_s_radio_completion_fn cb;
-	void *cb_data;
-
-	uint32_t cur_offset;
-	uint16_t block_len; /* Expected length, from the header */
-
-	uint8_t data[MAX_JSON_LEN+1];
-	uint16_t data_len;
-
-} rift_s_radio_json_read_state;
 
 static void
 read_json_cb (bool success, uint8_t *response_bytes, int response_bytes_len, rift_s_radio_json_read_state *json_read)
@@ -231,7 +246,7 @@ read_json_cb (bool success, uint8_t *response_bytes, int response_bytes_len, rif
 
 		if (json_read->cb)
 			json_read->cb (true, json_read->data, json_read->data_len, json_read->cb_data);
-		free (json_read);
+		omem_pool_free(&json_read->state->json_reads, json_read);
 		return;
 	}
 
@@ -245,16 +260,17 @@ read_json_cb (bool success, uint8_t *response_bytes, int response_bytes_len, rif
 	read_cmd[7] = json_read->cur_offset >> 24;
 	read_cmd[8] = read_len;
 
+	/* Advance first, a failed queue frees json_read through the callback */
+	json_read->cur_offset += read_len;
+
 	rift_s_radio_queue_command (json_read->state, json_read->device_id, read_cmd, sizeof(read_cmd),
 		(rift_s_radio_completion_fn) read_json_cb, json_read);
-
-	json_read->cur_offset += read_len;
 	return;
 
 fail:
 	if (json_read->cb)
 		json_read->cb (success, json_read->data, json_read->data_len, json_read->cb_data);
-	free (json_read);
+	omem_pool_free(&json_read->state->json_reads, json_read);
 	return;
 }
 
@@ -263,10 +279,16 @@ rift_s_radio_get_json_block (rift_s_radio_state *state, const uint64_t device_id
 		rift_s_radio_completion_fn cb, void *cb_data)
 {
 	/* Configuration JSON block reading */
-	rift_s_radio_json_read_state *json_read = ohmd_alloc (state->ctx, sizeof(rift_s_radio_json_read_state));
+	rift_s_radio_json_read_state *json_read = omem_pool_alloc (&state->json_reads);
 	/* cmd  = 0x2b  reply_buffer_len = 0x20  timeout(?) = 0x3e8 (=1000) offset = 0u32   len = 0x20 */
 	const uint8_t read_cmd[] = { 0x2b, 0x20, 0xe8, 0x03, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00 };
 
+	if (json_read == NULL) {
+		if (cb)
+			cb (false, NULL, 0, cb_data);
+		return;
+	}
+
 	json_read->state = state;
 	json_read->device_id = device_id;
 	json_read->cb = cb;
@@ -26,6 +26,11 @@ struct rift_s_radio_state {
 
 	rift_s_radio_command *pending_commands;
 	rift_s_radio_command *pending_commands_tail;
+
+	/* Recycled commands and JSON read states, so polling the
+	 * controllers doesn't go to the heap */
+	mem_pool commands;
+	mem_pool json_reads;
 };
 
 void rift_s_radio_state_init (rift_s_radio_state *state, ohmd_context *ctx);
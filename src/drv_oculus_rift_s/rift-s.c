@@ -29,6 +29,12 @@
 #define RIFT_S_INTF_STATUS 7
 #define RIFT_S_INTF_CONTROLLERS 8
 
+/* Set to 1 to read each interface on its own thread instead of polling them in turn */
+#define READER_THREADS_ENV "OHMD_RIFT_S_READER_THREADS"
+#define READER_QUEUE_LEN 128
+#define READER_TIMEOUT_MS 100 /* How long a reader takes to notice it should stop */
+#define SHARED_READER_TIMEOUT_MS 1 /* How long the update thread may wait for the HMD interface */
+
 typedef struct device_list_s device_list_t;
 struct device_list_s {
 	char path[OHMD_STR_SIZE];
@@ -119,7 +125,7 @@ vec3f_rotate_3x3(vec3f *vec, float rot[3][3])
 }
 
 static void
-handle_hmd_report (rift_s_hmd_t *priv, const unsigned char *buf, int size)
+handle_hmd_report (rift_s_hmd_t *priv, const unsigned char *buf, int size, double now)
 {
 	rift_s_hmd_report_t report;
 
@@ -178,6 +184,9 @@ handle_hmd_report (rift_s_hmd_t *priv, const unsigned char *buf, int size)
 			priv->raw_gyro.x, priv->raw_gyro.y, priv->raw_gyro.z);
 #endif
 
+		/* The report timestamp is that of the first sample */
+		ofusion_set_sample_time(&priv->sensor_fusion,
+			oclock_sync_update(&priv->imu_clock, report.timestamp + i * TICK_LEN_US, now));
 		ofusion_update(&priv->sensor_fusion, dt_sec, &priv->raw_gyro, &priv->raw_accel, &priv->raw_mag);
 		end_ts += dt;
 		dt = TICK_LEN_US;
@@ -186,6 +195,153 @@ handle_hmd_report (rift_s_hmd_t *priv, const unsigned char *buf, int size)
 	priv->last_imu_timestamp = end_ts;
 }
 
+static void handle_report(rift_s_hmd_t *priv, const unsigned char *buf, int size, double now)
+{
+	if (buf[0] == 0x65)
+		handle_hmd_report (priv, buf, size, now);
+	else if (buf[0] == 0x67)
+		rift_s_handle_controller_report (priv, priv->handles[0], buf, size, now);
+	else if (buf[0] == 0x66) {
+		// System state packet. Enable the screen if the prox sensor is
+		// triggered
+		bool prox_sensor = (buf[1] == 0) ? false : true;
+		if (prox_sensor != priv->display_on) {
+			rift_s_hmd_lock_handle (priv);
+			rift_s_set_screen_enable (priv->handles[0], prox_sensor);
+			rift_s_hmd_unlock_handle (priv);
+			priv->display_on = prox_sensor;
+		}
+	}
+	else
+	 LOGW("Unknown Rift S report 0x%02x!", buf[0]);
+}
+
+/* hidapi handles aren't thread safe. With readers, the update thread still
+ * sends and gets feature reports on the HMD interface, so it and the reader
+ * of that interface take handle_lock around every use. The reader only
+ * holds it for SHARED_READER_TIMEOUT_MS at a time, and steps aside while
+ * the update thread waits for it. */
+void rift_s_hmd_lock_handle(rift_s_hmd_t *hmd)
+{
+	if (!hmd->use_readers)
+		return;
+
+	ohmd_atomic_store(&hmd->handle_wanted, 1);
+	ohmd_lock_mutex(hmd->handle_lock);
+	ohmd_atomic_store(&hmd->handle_wanted, 0);
+}
+
+void rift_s_hmd_unlock_handle(rift_s_hmd_t *hmd)
+{
+	if (hmd->use_readers)
+		ohmd_unlock_mutex(hmd->handle_lock);
+}
+
+static unsigned int reader_thread(void *arg)
+{
+	rift_s_reader *reader = arg;
+	rift_s_hmd_t *hmd = reader->hmd;
+	rift_s_queued_report report;
+
+	while (!ohmd_atomic_load(&hmd->readers_quit)) {
+		if (reader->lock) {
+			while (ohmd_atomic_load(&hmd->handle_wanted) && !ohmd_atomic_load(&hmd->readers_quit))
+				ohmd_sleep(0.0001);
+
+			ohmd_lock_mutex(reader->lock);
+			report.size = hid_read_timeout(reader->handle, report.buf, FEATURE_BUFFER_SIZE, SHARED_READER_TIMEOUT_MS);
+			ohmd_unlock_mutex(reader->lock);
+		}
+		else {
+			report.size = hid_read_timeout(reader->handle, report.buf, FEATURE_BUFFER_SIZE, READER_TIMEOUT_MS);
+		}
+
+		if (report.size < 0) {
+			LOGE("error reading from HMD device, stopping its reader");
+			break;
+		} else if (report.size == 0) {
+			continue;
+		}
+
+		/* Stamped here, so the clock sync doesn't see the queueing delay */
+		report.time = ohmd_get_tick();
+		ospsc_queue_push(&reader->queue, &report);
+	}
+
+	return 0;
+}
+
+static void drain_reader(rift_s_hmd_t *priv, rift_s_reader *reader)
+{
+	rift_s_queued_report report;
+
+	while (ospsc_queue_pop(&reader->queue, &report))
+		handle_report (priv, report.buf, report.size, report.time);
+
+	uint32_t dropped = ohmd_atomic_load(&reader->queue.dropped);
+	if (dropped != reader->last_dropped) {
+		LOGW("Rift S reader queue full, dropped %u reports", dropped - reader->last_dropped);
+		reader->last_dropped = dropped;
+	}
+}
+
+static void stop_readers(rift_s_hmd_t *priv)
+{
+	ohmd_atomic_store(&priv->readers_quit, 1);
+
+	for (int i = 0; i < 3; i++) {
+		rift_s_reader *reader = priv->readers + i;
+
+		if (reader->thread)
+			ohmd_destroy_thread(reader->thread);
+		ospsc_queue_destroy(&reader->queue);
+		reader->thread = NULL;
+		reader->lock = NULL;
+	}
+
+	if (priv->handle_lock)
+		ohmd_destroy_mutex(priv->handle_lock);
+	priv->handle_lock = NULL;
+
+	priv->use_readers = false;
+}
+
+static bool start_readers(rift_s_hmd_t *priv)
+{
+	priv->readers_quit = 0;
+	priv->handle_wanted = 0;
+
+	priv->handle_lock = ohmd_create_mutex(priv->ctx);
+	if (priv->handle_lock == NULL)
+		goto fail;
+
+	for (int i = 0; i < 3; i++) {
+		rift_s_reader *reader = priv->readers + i;
+
+		reader->hmd = priv;
+		reader->handle = priv->handles[i];
+		reader->lock = (i == 0) ? priv->handle_lock : NULL;
+		if (!ospsc_queue_init(&reader->queue, priv->ctx, sizeof(rift_s_queued_report), READER_QUEUE_LEN))
+			goto fail;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		rift_s_reader *reader = priv->readers + i;
+
+		/* The handles stay non-blocking, the readers wait in hid_read_timeout */
+		reader->thread = ohmd_create_thread(priv->ctx, reader_thread, reader);
+		if (reader->thread == NULL)
+			goto fail;
+	}
+
+	priv->use_readers = true;
+	return true;
+
+fail:
+	stop_readers (priv);
+	return false;
+}
+
 static void update_hmd(rift_s_hmd_t *priv)
 {
 	unsigned char buf[FEATURE_BUFFER_SIZE];
@@ -194,44 +350,45 @@ static void update_hmd(rift_s_hmd_t *priv)
 	double t = ohmd_get_tick();
 	if(t - priv->last_keep_alive >= ((double)(KEEPALIVE_INTERVAL_MS) / 1000.0)) {
 		// send keep alive message
+		rift_s_hmd_lock_handle (priv);
 		rift_s_send_keepalive (priv->handles[0]);
+		rift_s_hmd_unlock_handle (priv);
 		// Update the time of the last keep alive we have sent.
 		priv->last_keep_alive = t;
 	}
 
-	/* Poll each of the 3 devices for messages and process them */
-	for (int i = 0; i < 3; i++) {
-		if (priv->handles[i] == NULL)
-				continue;
-
-		while(true){
-			int size = hid_read(priv->handles[i], buf, FEATURE_BUFFER_SIZE);
-			if(size < 0){
-				LOGE("error reading from HMD device");
-				break;
-			} else if(size == 0) {
-				break; // No more messages, return.
-			}
-
-			if (buf[0] == 0x65)
-				handle_hmd_report (priv, buf, size);
-			else if (buf[0] == 0x67)
-				rift_s_handle_controller_report (priv, priv->handles[0], buf, size);
-			else if (buf[0] == 0x66) {
-				// System state packet. Enable the screen if the prox sensor is
-				// triggered
-				bool prox_sensor = (buf[1] == 0) ? false : true;
-				if (prox_sensor != priv->display_on) {
-					rift_s_set_screen_enable (priv->handles[0], prox_sensor);
-					priv->display_on = prox_sensor;
+	if (priv->use_readers) {
+		/* The HMD interface comes first, so a burst of controller
+		 * reports never delays the HMD IMU samples */
+		for (int i = 0; i < 3; i++)
+			drain_reader (priv, priv->readers + i);
+	}
+	else {
+		/* Poll each of the 3 devices for messages and process them */
+		for (int i = 0; i < 3; i++) {
+			if (priv->handles[i] == NULL)
+					continue;
+
+			while(true){
+				int size = hid_read(priv->handles[i], buf, FEATURE_BUFFER_SIZE);
+				if(size < 0){
+					LOGE("error reading from HMD device");
+					break;
+				} else if(size == 0) {
+					break; // No more messages, return.
 				}
+
+				handle_report (priv, buf, size, ohmd_get_tick());
 			}
-			else
-			 LOGW("Unknown Rift S report 0x%02x!", buf[0]);
 		}
 	}
 
-	rift_s_radio_update (&priv->radio_state, priv->handles[0]);
+	/* The radio only talks to the HMD when it has a command going */
+	if (priv->radio_state.command_result_pending || priv->radio_state.pending_commands) {
+		rift_s_hmd_lock_handle (priv);
+		rift_s_radio_update (&priv->radio_state, priv->handles[0]);
+		rift_s_hmd_unlock_handle (priv);
+	}
 }
 
 static void update_device(ohmd_device* device)
@@ -376,6 +533,7 @@ static void init_touch_device(rift_s_controller_device *touch, int id)
 	ohmd_set_default_device_properties(&ohmd_dev->properties);
 
 	ohmd_dev->properties.control_count = 8;
+	ohmd_dev->reports_controls = true;
 
 	if (id == 1) { // Right controller
 		ohmd_dev->properties.controls_hints[0] = OHMD_BUTTON_A;
@@ -501,6 +659,8 @@ static rift_s_hmd_t *open_hmd(ohmd_driver* driver, ohmd_device_desc* desc)
 
 	// initialize sensor fusion
 	ofusion_init(&priv->sensor_fusion);
+	hmd_dev->base.fusion = &priv->sensor_fusion;
+	oclock_sync_init(&priv->imu_clock, 1000000.0, 32);
 
 	// Init touch devices 
 	for (int i = 0; i < MAX_CONTROLLERS; i++)
@@ -511,6 +671,10 @@ static rift_s_hmd_t *open_hmd(ohmd_driver* driver, ohmd_device_desc* desc)
 			goto cleanup;
 	}
 
+	const char *readers = getenv(READER_THREADS_ENV);
+	if (readers && strcmp(readers, "1") == 0 && !start_readers (priv))
+		LOGW("Failed to start the Rift S reader threads, polling instead");
+
 	return priv;
 
 cleanup:
@@ -521,6 +685,9 @@ cleanup:
 
 static void close_hmd(rift_s_hmd_t *hmd)
 {
+	if (hmd->use_readers)
+		stop_readers (hmd);
+
 	rift_s_radio_state_clear (&hmd->radio_state);
 
 	if (hmd->handles[0]) {
@@ -636,7 +803,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 		while (cur_dev) {
 			if(rd[i].iface == -1 || cur_dev->interface_number == rd[i].iface) {
 				int id = 0;
-				ohmd_device_desc* desc = &list->devices[list->num_devices++];
+				ohmd_device_desc* desc = ohmd_device_list_add(list);
 
 				strcpy(desc->driver, "OpenHMD Rift Driver");
 				strcpy(desc->vendor, "Oculus VR, Inc.");
@@ -653,7 +820,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 				desc->id = id++;
 
 				//Controller 0 (left)
-				desc = &list->devices[list->num_devices++];
+				desc = ohmd_device_list_add(list);
 				desc->revision = 0;
 
 				strcpy(desc->driver, "OpenHMD Rift Driver");
@@ -672,7 +839,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 				desc->id = id++;
 
 				// Controller 1 (right)
-				desc = &list->devices[list->num_devices++];
+				desc = ohmd_device_list_add(list);
 				desc->revision = 0;
 
 				strcpy(desc->driver, "OpenHMD Rift Driver");
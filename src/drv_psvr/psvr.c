@@ -32,6 +32,7 @@ typedef struct {
 	hid_device* hmd_handle;
 	hid_device* hmd_control;
 	fusion sensor_fusion;
+	clock_sync imu_clock;
 	vec3f raw_accel, raw_gyro;
 	uint8_t last_seq;
 	uint8_t buttons;
@@ -95,12 +96,15 @@ static void handle_tracker_sensor_msg(psvr_priv* priv, unsigned char* buffer, in
 	}
 
 	vec3f mag = {{0.0f, 0.0f, 0.0f}};
+	double now = ohmd_get_tick();
 
 	for (int i = 0; i < 2; i++) {
 		float dt = tick_delta * TICK_LEN;
 		accel_from_psvr_vec(s->samples[i].accel, &priv->raw_accel);
 		gyro_from_psvr_vec(s->samples[i].gyro, &priv->raw_gyro);
 
+		ofusion_set_sample_time(&priv->sensor_fusion,
+			oclock_sync_update(&priv->imu_clock, s->samples[i].tick, now));
 		ofusion_update(&priv->sensor_fusion, dt, &priv->raw_gyro, &priv->raw_accel, &mag);
 
 		if (i == 0) {
@@ -304,6 +308,8 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 	priv->base.getf = getf;
 
 	ofusion_init(&priv->sensor_fusion);
+	priv->base.fusion = &priv->sensor_fusion;
+	oclock_sync_init(&priv->imu_clock, 1.0 / TICK_LEN, 24);
 
 	return (ohmd_device*)priv;
 
@@ -336,7 +342,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 
 		// Register one device for each IMU sensor interface
 		if (cur_dev->interface_number == 4) {
-			desc = &list->devices[list->num_devices++];
+			desc = ohmd_device_list_add(list);
 
 			strcpy(desc->driver, "OpenHMD Sony PSVR Driver");
 			strcpy(desc->vendor, "Sony");
@@ -0,0 +1,216 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Shared Memory Pose Server */
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "shm.h"
+
+#define MAX_READ_RETRIES 1000 // a server that died mid write leaves seq odd forever
+
+struct shm_server {
+	ohmd_context* ctx;
+	char name[OHMD_STR_SIZE];
+	shm_segment* seg;
+	ohmd_device* owners[SHM_MAX_DEVICES];
+	uint32_t next_generation;
+};
+
+void oshm_write_begin(shm_device* slot)
+{
+	__atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void oshm_write_end(shm_device* slot)
+{
+	__atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELEASE);
+}
+
+bool oshm_read(const shm_device* slot, uint32_t generation, const void* src, void* dst, size_t len)
+{
+	for(int i = 0; i < MAX_READ_RETRIES; i++){
+		uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+		if(seq & 1)
+			continue;
+
+		memcpy(dst, src, len);
+		uint32_t gen = slot->generation;
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if(__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq)
+			return gen == generation;
+	}
+
+	return false;
+}
+
+static bool server_alive(int32_t pid)
+{
+	return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+shm_server* oshm_server_create(ohmd_context* ctx, const char* name)
+{
+	shm_server* me = ohmd_alloc(ctx, sizeof(shm_server));
+	if(!me)
+		return NULL;
+
+	me->ctx = ctx;
+	me->next_generation = 1;
+	snprintf(me->name, OHMD_STR_SIZE, "%s", name);
+
+	int fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+	if(fd < 0){
+		ohmd_set_error(ctx, "could not open shared memory %s: %s", name, strerror(errno));
+		free(me);
+		return NULL;
+	}
+
+	if(ftruncate(fd, sizeof(shm_segment)) < 0){
+		ohmd_set_error(ctx, "could not size shared memory %s: %s", name, strerror(errno));
+		close(fd);
+		free(me);
+		return NULL;
+	}
+
+	me->seg = mmap(NULL, sizeof(shm_segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if(me->seg == MAP_FAILED){
+		ohmd_set_error(ctx, "could not map shared memory %s: %s", name, strerror(errno));
+		free(me);
+		return NULL;
+	}
+
+	if(me->seg->magic == SHM_MAGIC && me->seg->server_pid != getpid() && server_alive(me->seg->server_pid)){
+		ohmd_set_error(ctx, "shared memory %s is already served by process %d", name, me->seg->server_pid);
+		munmap(me->seg, sizeof(shm_segment));
+		free(me);
+		return NULL;
+	}
+
+	// a left over segment from a dead server is reused, readers see the generations change
+	for(int i = 0; i < SHM_MAX_DEVICES; i++){
+		shm_device* slot = me->seg->devices + i;
+		if(slot->generation >= me->next_generation)
+			me->next_generation = slot->generation + 1;
+
+		oshm_write_begin(slot);
+		slot->generation = 0;
+		oshm_write_end(slot);
+	}
+
+	me->seg->version = SHM_VERSION;
+	me->seg->size = sizeof(shm_segment);
+	me->seg->server_pid = getpid();
+	__atomic_store_n(&me->seg->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+
+	return me;
+}
+
+void oshm_server_destroy(shm_server* me)
+{
+	for(int i = 0; i < SHM_MAX_DEVICES; i++){
+		shm_device* slot = me->seg->devices + i;
+		oshm_write_begin(slot);
+		slot->generation = 0;
+		oshm_write_end(slot);
+	}
+
+	// clients that still have it mapped see no devices, new ones don't find it
+	munmap(me->seg, sizeof(shm_segment));
+	shm_unlink(me->name);
+	free(me);
+}
+
+const char* oshm_server_get_name(const shm_server* me)
+{
+	return me->name;
+}
+
+static int find_slot(shm_server* me, ohmd_device* device)
+{
+	for(int i = 0; i < SHM_MAX_DEVICES; i++){
+		if(me->owners[i] == device)
+			return i;
+	}
+
+	return -1;
+}
+
+void oshm_server_publish(shm_server* me, ohmd_device* device)
+{
+	int idx = find_slot(me, device);
+	shm_device* slot;
+
+	if(idx < 0){
+		idx = find_slot(me, NULL);
+		if(idx < 0)
+			return;
+
+		me->owners[idx] = device;
+		slot = me->seg->devices + idx;
+
+		oshm_write_begin(slot);
+		slot->generation = me->next_generation++;
+		slot->desc = device->desc;
+		slot->desc.driver_ptr = NULL;
+		slot->properties = device->properties;
+		memset(&slot->state, 0, sizeof(shm_state));
+		oshm_write_end(slot);
+	}
+
+	slot = me->seg->devices + idx;
+
+	shm_state state;
+	memset(&state, 0, sizeof(shm_state));
+	state.publish_time = ohmd_get_tick();
+	memcpy(state.rotation, &device->rotation, sizeof(state.rotation));
+	memcpy(state.position, &device->position, sizeof(state.position));
+
+	int count = OHMD_MIN(device->properties.control_count, SHM_MAX_CONTROLS);
+	if(count > 0){
+		float controls[SHM_MAX_CONTROLS];
+		if(device->getf(device, OHMD_CONTROLS_STATE, controls) == OHMD_S_OK)
+			memcpy(state.controls, controls, sizeof(float) * count);
+	}
+
+	if(device->fusion){
+		state.flags |= SHM_FLAG_FUSION;
+		state.orient = device->fusion->orient;
+		state.ang_vel = device->fusion->ang_vel;
+		state.sample_time = device->fusion->sample_time;
+	}
+
+	oshm_write_begin(slot);
+	slot->state = state;
+	oshm_write_end(slot);
+}
+
+void oshm_server_remove(shm_server* me, ohmd_device* device)
+{
+	int idx = find_slot(me, device);
+	if(idx < 0)
+		return;
+
+	shm_device* slot = me->seg->devices + idx;
+	oshm_write_begin(slot);
+	slot->generation = 0;
+	oshm_write_end(slot);
+
+	me->owners[idx] = NULL;
+}
@@ -0,0 +1,234 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Shared Memory Client Driver */
+
+/*
+ * Lists and opens the devices another process publishes with ohmd_ctx_publish.
+ * Poses are read straight from the mapped segment, the core filters and
+ * corrections are then applied per client like for any other driver.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "shm.h"
+
+typedef struct {
+	ohmd_device base;
+
+	shm_segment* seg;
+	const shm_device* slot;
+	uint32_t generation;
+
+	shm_state state; // last consistent copy, kept if the server goes away
+	bool lost;
+
+	fusion sensor_fusion;
+} shm_priv;
+
+static const char* segment_name()
+{
+	const char* name = getenv(SHM_NAME_ENV);
+	return name && *name ? name : SHM_DEFAULT_NAME;
+}
+
+static shm_segment* map_segment(const char* name)
+{
+	int fd = shm_open(name, O_RDONLY, 0);
+	if(fd < 0)
+		return NULL;
+
+	struct stat st;
+	if(fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(shm_segment)){
+		close(fd);
+		return NULL;
+	}
+
+	shm_segment* seg = mmap(NULL, sizeof(shm_segment), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if(seg == MAP_FAILED)
+		return NULL;
+
+	bool alive = seg->server_pid > 0 && (kill(seg->server_pid, 0) == 0 || errno == EPERM);
+
+	if(__atomic_load_n(&seg->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC || seg->version != SHM_VERSION ||
+	   seg->size != sizeof(shm_segment) || !alive){
+		munmap(seg, sizeof(shm_segment));
+		return NULL;
+	}
+
+	return seg;
+}
+
+static void read_state(shm_priv* priv)
+{
+	shm_state state;
+
+	if(oshm_read(priv->slot, priv->generation, &priv->slot->state, &state, sizeof(shm_state))){
+		priv->state = state;
+		priv->lost = false;
+	} else if(!priv->lost){
+		LOGW("shared memory device went away, keeping the last pose");
+		priv->lost = true;
+	}
+}
+
+static void update_device(ohmd_device* device)
+{
+	shm_priv* priv = (shm_priv*)device;
+	read_state(priv);
+
+	if(priv->state.flags & SHM_FLAG_FUSION){
+		priv->sensor_fusion.orient = priv->state.orient;
+		priv->sensor_fusion.ang_vel = priv->state.ang_vel;
+		if(priv->state.sample_time > 0)
+			ofusion_set_sample_time(&priv->sensor_fusion, priv->state.sample_time);
+	}
+}
+
+static int getf(ohmd_device* device, ohmd_float_value type, float* out)
+{
+	shm_priv* priv = (shm_priv*)device;
+
+	switch(type){
+	case OHMD_ROTATION_QUAT:
+		read_state(priv);
+		memcpy(out, priv->state.rotation, sizeof(float) * 4);
+		break;
+
+	case OHMD_POSITION_VECTOR:
+		read_state(priv);
+		memcpy(out, priv->state.position, sizeof(float) * 3);
+		break;
+
+	case OHMD_CONTROLS_STATE:
+		read_state(priv);
+		memcpy(out, priv->state.controls, sizeof(float) * OHMD_MIN(priv->base.properties.control_count, SHM_MAX_CONTROLS));
+		break;
+
+	case OHMD_DISTORTION_K:
+		// the universal distortion values are in the properties, like most drivers
+		memset(out, 0, sizeof(float) * 6);
+		break;
+
+	default:
+		ohmd_set_error(priv->base.ctx, "invalid type given to getf (%d)", type);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	return OHMD_S_OK;
+}
+
+static void close_device(ohmd_device* device)
+{
+	LOGD("closing shared memory device");
+	shm_priv* priv = (shm_priv*)device;
+	munmap(priv->seg, sizeof(shm_segment));
+	free(priv);
+}
+
+static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
+{
+	shm_segment* seg = map_segment(segment_name());
+	if(!seg){
+		ohmd_set_error(driver->ctx, "shared memory %s is not served", segment_name());
+		return NULL;
+	}
+
+	shm_priv* priv = ohmd_alloc(driver->ctx, sizeof(shm_priv));
+	if(!priv){
+		munmap(seg, sizeof(shm_segment));
+		return NULL;
+	}
+
+	priv->seg = seg;
+	priv->slot = seg->devices + desc->id;
+	priv->generation = (uint32_t)desc->revision;
+
+	if(!oshm_read(priv->slot, priv->generation, &priv->slot->properties, &priv->base.properties, sizeof(ohmd_device_properties))){
+		ohmd_set_error(driver->ctx, "shared memory device %d is no longer served", desc->id);
+		munmap(seg, sizeof(shm_segment));
+		free(priv);
+		return NULL;
+	}
+
+	ofusion_init(&priv->sensor_fusion);
+	read_state(priv);
+	if(priv->state.flags & SHM_FLAG_FUSION)
+		priv->base.fusion = &priv->sensor_fusion;
+
+	priv->base.update = update_device;
+	priv->base.close = close_device;
+	priv->base.getf = getf;
+
+	return (ohmd_device*)priv;
+}
+
+static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
+{
+	const char* name = segment_name();
+
+	// a context doesn't list what it serves itself
+	if(driver->ctx->shm_server && strcmp(oshm_server_get_name(driver->ctx->shm_server), name) == 0)
+		return;
+
+	shm_segment* seg = map_segment(name);
+	if(!seg)
+		return;
+
+	for(int i = 0; i < SHM_MAX_DEVICES; i++){
+		const shm_device* slot = seg->devices + i;
+		uint32_t generation = __atomic_load_n(&slot->generation, __ATOMIC_ACQUIRE);
+		if(generation == 0)
+			continue;
+
+		ohmd_device_desc served;
+		if(!oshm_read(slot, generation, &slot->desc, &served, sizeof(ohmd_device_desc)))
+			continue;
+
+		ohmd_device_desc* desc = ohmd_device_list_add(list);
+		*desc = served;
+
+		strcpy(desc->driver, "OpenHMD Shared Memory Client");
+		snprintf(desc->path, OHMD_STR_SIZE, "shm:%s:%d", name, i);
+
+		desc->id = i;
+		desc->revision = (int)generation;
+		desc->driver_ptr = driver;
+	}
+
+	munmap(seg, sizeof(shm_segment));
+}
+
+static void destroy_driver(ohmd_driver* drv)
+{
+	LOGD("shutting down shared memory driver");
+	free(drv);
+}
+
+ohmd_driver* ohmd_create_shm_drv(ohmd_context* ctx)
+{
+	ohmd_driver* drv = ohmd_alloc(ctx, sizeof(ohmd_driver));
+	if(!drv)
+		return NULL;
+
+	drv->get_device_list = get_device_list;
+	drv->open_device = open_device;
+	drv->destroy = destroy_driver;
+	drv->ctx = ctx;
+
+	return drv;
+}
@@ -0,0 +1,76 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Shared Memory Pose Transport */
+
+
+#ifndef SHM_H
+#define SHM_H
+
+#include "../openhmdi.h"
+
+#define SHM_MAGIC 0x444d484f // "OHMD"
+#define SHM_VERSION 1
+#define SHM_DEFAULT_NAME "/openhmd"
+#define SHM_NAME_ENV "OHMD_SHM_NAME"
+#define SHM_MAX_DEVICES 16
+#define SHM_MAX_CONTROLS 64
+
+#define SHM_FLAG_FUSION 1 // orient and ang_vel are valid
+
+// changes on every update
+typedef struct {
+	double publish_time; // host time of the update, see ohmd_get_time
+	double sample_time;  // host time of the newest sensor sample, 0 if unknown
+
+	float rotation[4];   // as returned by the driver, before the core filters and corrections
+	float position[3];
+	float controls[SHM_MAX_CONTROLS];
+
+	int flags;
+	quatf orient;        // fusion orientation and sensor frame angular velocity, for prediction
+	vec3f ang_vel;
+} shm_state;
+
+/*
+ * One device, written by the server only. Readers copy what they need and
+ * retry if seq was odd or changed meanwhile, so they never block the server
+ * and never make a syscall.
+ */
+typedef struct {
+	uint32_t seq;
+	uint32_t generation; // 0 for a free slot, changes when the slot is reused
+
+	ohmd_device_desc desc; // driver_ptr is meaningless to readers
+	ohmd_device_properties properties;
+
+	shm_state state;
+} shm_device;
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t size;       // sizeof(shm_segment), different builds don't mix
+	int32_t server_pid;
+
+	shm_device devices[SHM_MAX_DEVICES];
+} shm_segment;
+
+typedef struct shm_server shm_server;
+
+// server side, all called with the update mutex held
+shm_server* oshm_server_create(ohmd_context* ctx, const char* name);
+void oshm_server_destroy(shm_server* me);
+const char* oshm_server_get_name(const shm_server* me);
+void oshm_server_publish(shm_server* me, ohmd_device* device);
+void oshm_server_remove(shm_server* me, ohmd_device* device);
+
+// seqlock
+void oshm_write_begin(shm_device* slot);
+void oshm_write_end(shm_device* slot);
+bool oshm_read(const shm_device* slot, uint32_t generation, const void* src, void* dst, size_t len);
+
+#endif
@@ -606,6 +606,7 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 
     if (priv->ofusion) {
         ofusion_init(&priv->ofusion->sensor_fusion);
+        priv->device.fusion = &priv->ofusion->sensor_fusion;
 
         /* Known initial value for startup correction */
         priv->hmd_data.message_num = 256;
@@ -633,7 +634,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
     while (cur_dev) {
         if (ohmd_wstring_match(cur_dev->manufacturer_string, L"STMicroelectronics") &&
                         ohmd_wstring_match(cur_dev->product_string, L"HID")) {
-            ohmd_device_desc* desc = &list->devices[list->num_devices++];
+            ohmd_device_desc* desc = ohmd_device_list_add(list);
 
             strcpy(desc->driver, "OpenHMD VR-Tek Driver");
             strcpy(desc->vendor, "VR-Tek");
@@ -32,6 +32,7 @@ typedef struct {
 
 	hid_device* hmd_imu;
 	fusion sensor_fusion;
+	clock_sync imu_clock;
 	vec3f raw_accel, raw_gyro;
 	uint32_t last_ticks;
 	uint8_t last_seq;
@@ -86,6 +87,7 @@ static void handle_tracker_sensor_msg(wmr_priv* priv, unsigned char* buffer, int
 
 
 	vec3f mag = {{0.0f, 0.0f, 0.0f}};
+	double now = ohmd_get_tick();
 
 	for(int i = 0; i < 4; i++){
 		uint64_t tick_delta = 1000;
@@ -97,6 +99,8 @@ static void handle_tracker_sensor_msg(wmr_priv* priv, unsigned char* buffer, int
 		vec3f_from_hololens_gyro(s->gyro, i, &priv->raw_gyro);
 		vec3f_from_hololens_accel(s->accel, i, &priv->raw_accel);
 
+		ofusion_set_sample_time(&priv->sensor_fusion,
+			oclock_sync_update(&priv->imu_clock, s->gyro_timestamp[i], now));
 		ofusion_update(&priv->sensor_fusion, dt, &priv->raw_gyro, &priv->raw_accel, &mag);
 
 		last_sample_tick = s->gyro_timestamp[i];
@@ -445,6 +449,8 @@ static ohmd_device* open_device(ohmd_driver* driver, ohmd_device_desc* desc)
 	priv->base.getf = getf;
 
 	ofusion_init(&priv->sensor_fusion);
+	priv->base.fusion = &priv->sensor_fusion;
+	oclock_sync_init(&priv->imu_clock, 1.0 / TICK_LEN, 64);
 
 	return (ohmd_device*)priv;
 
@@ -462,7 +468,7 @@ static void get_device_list(ohmd_driver* driver, ohmd_device_list* list)
 
 	int idx = 0;
 	while (cur_dev) {
-		ohmd_device_desc* desc = &list->devices[list->num_devices++];
+		ohmd_device_desc* desc = ohmd_device_list_add(list);
 
 		strcpy(desc->driver, "OpenHMD Windows Mixed Reality Driver");
 		strcpy(desc->vendor, "Microsoft");
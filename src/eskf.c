@@ -0,0 +1,379 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Error-State Kalman Filter Implementation */
+
+/*
+ * The nominal state (orientation, gyro bias and optionally velocity and
+ * position) is propagated with the raw IMU samples, while a small error state
+ * with its covariance tracks how wrong the nominal state is. Measurements
+ * estimate the error state which is then folded back into the nominal state.
+ *
+ * The orientation error is expressed in the body frame, q_true = q * dq(d_theta).
+ * The accelerometer is expected to read +g on the world Y axis when at rest.
+ *
+ * All matrices are fixed size and live in the eskf_state, nothing is allocated.
+ */
+
+#include <string.h>
+#include "eskf.h"
+
+#define N ESKF_MAX_STATES
+
+#define IDX_THETA 0
+#define IDX_BIAS 3
+#define IDX_VEL 6
+#define IDX_POS 9
+
+// skew symmetric cross product matrix, [v]x * u = v x u
+static void skew(const vec3f* v, float out[3][3])
+{
+	out[0][0] =  0;     out[0][1] = -v->z; out[0][2] =  v->y;
+	out[1][0] =  v->z;  out[1][1] =  0;    out[1][2] = -v->x;
+	out[2][0] = -v->y;  out[2][1] =  v->x; out[2][2] =  0;
+}
+
+static bool invert3(const float m[3][3], float out[3][3])
+{
+	float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+	float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+
+	float det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+	if(fabsf(det) < 1e-30f)
+		return false;
+
+	float inv_det = 1.0f / det;
+
+	out[0][0] = c00 * inv_det;
+	out[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv_det;
+	out[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv_det;
+	out[1][0] = c01 * inv_det;
+	out[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv_det;
+	out[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv_det;
+	out[2][0] = c02 * inv_det;
+	out[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv_det;
+	out[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv_det;
+
+	return true;
+}
+
+static void symmetrize(eskf_state* me)
+{
+	for(int i = 0; i < me->n; i++){
+		for(int j = i + 1; j < me->n; j++){
+			float v = 0.5f * (me->P[i][j] + me->P[j][i]);
+			me->P[i][j] = me->P[j][i] = v;
+		}
+
+		// keep the covariance from collapsing due to float round-off
+		if(me->P[i][i] < 1e-12f)
+			me->P[i][i] = 1e-12f;
+	}
+}
+
+static void quat_conj(const quatf* q, quatf* out)
+{
+	out->x = -q->x;
+	out->y = -q->y;
+	out->z = -q->z;
+	out->w = q->w;
+}
+
+static void quat_from_rotvec(const vec3f* v, quatf* out)
+{
+	float angle = ovec3f_get_length(v);
+
+	if(angle > 1e-6f){
+		oquatf_init_axis(out, v, angle);
+	} else {
+		// small angle approximation
+		out->x = v->x * 0.5f;
+		out->y = v->y * 0.5f;
+		out->z = v->z * 0.5f;
+		out->w = 1.0f;
+		oquatf_normalize_me(out);
+	}
+}
+
+static void init_orientation(eskf_state* me, const vec3f* accel)
+{
+	vec3f a = *accel;
+	vec3f up = {{0, 1.0f, 0}};
+
+	me->orient = (quatf){{0, 0, 0, 1.0f}};
+
+	if(ovec3f_get_length(&a) < 1e-6f)
+		return;
+
+	ovec3f_normalize_me(&a);
+
+	// shortest rotation taking the measured gravity direction to world up
+	vec3f axis = {{a.y * up.z - a.z * up.y, a.z * up.x - a.x * up.z, a.x * up.y - a.y * up.x}};
+	float angle = ovec3f_get_angle(&a, &up);
+
+	if(ovec3f_get_length(&axis) < 1e-6f){
+		if(a.y > 0)
+			return;
+		axis = (vec3f){{1.0f, 0, 0}};
+	}
+
+	oquatf_init_axis(&me->orient, &axis, angle);
+}
+
+static void inject(eskf_state* me, const float dx[N])
+{
+	vec3f d_theta = {{dx[IDX_THETA + 0], dx[IDX_THETA + 1], dx[IDX_THETA + 2]}};
+	quatf dq;
+
+	quat_from_rotvec(&d_theta, &dq);
+	oquatf_mult_me(&me->orient, &dq);
+	oquatf_normalize_me(&me->orient);
+
+	for(int i = 0; i < 3; i++)
+		me->gyro_bias.arr[i] += dx[IDX_BIAS + i];
+
+	if(me->flags & ESKF_FLAG_POSITION){
+		for(int i = 0; i < 3; i++){
+			me->vel.arr[i] += dx[IDX_VEL + i];
+			me->pos.arr[i] += dx[IDX_POS + i];
+		}
+	}
+}
+
+/*
+ * Generic correction for a 3 dimensional measurement, given P * H^T (n x 3),
+ * the innovation covariance S (3 x 3) and the innovation y.
+ */
+static bool correct3(eskf_state* me, float PHt[N][3], float S[3][3], const vec3f* y)
+{
+	float S_inv[3][3], K[N][3], dx[N];
+	int n = me->n;
+
+	if(!invert3(S, S_inv))
+		return false;
+
+	for(int i = 0; i < n; i++){
+		for(int j = 0; j < 3; j++)
+			K[i][j] = PHt[i][0] * S_inv[0][j] + PHt[i][1] * S_inv[1][j] + PHt[i][2] * S_inv[2][j];
+
+		dx[i] = K[i][0] * y->x + K[i][1] * y->y + K[i][2] * y->z;
+	}
+
+	for(int i = n; i < N; i++)
+		dx[i] = 0;
+
+	// P = P - K * (H * P), with H * P = (P * H^T)^T as P is symmetric
+	for(int i = 0; i < n; i++)
+		for(int j = 0; j < n; j++)
+			me->P[i][j] -= K[i][0] * PHt[j][0] + K[i][1] * PHt[j][1] + K[i][2] * PHt[j][2];
+
+	symmetrize(me);
+	inject(me, dx);
+
+	return true;
+}
+
+void oeskf_init(eskf_state* me, int flags)
+{
+	memset(me, 0, sizeof(eskf_state));
+
+	me->flags = flags;
+	me->n = (flags & ESKF_FLAG_POSITION) ? ESKF_MAX_STATES : ESKF_ORIENT_STATES;
+	me->orient.w = 1.0f;
+
+	me->gyro_noise = 2e-3f;
+	me->gyro_bias_noise = 1e-4f;
+	me->accel_noise = 5e-2f;
+	me->gravity_noise = 0.1f;
+	me->gravity_gate = 0.8f;
+	me->gravity = 9.82f;
+
+	for(int i = 0; i < 3; i++){
+		me->P[IDX_THETA + i][IDX_THETA + i] = POW2(0.1f);
+		me->P[IDX_BIAS + i][IDX_BIAS + i] = POW2(0.02f);
+
+		if(flags & ESKF_FLAG_POSITION){
+			me->P[IDX_VEL + i][IDX_VEL + i] = 1.0f;
+			me->P[IDX_POS + i][IDX_POS + i] = 1.0f;
+		}
+	}
+}
+
+void oeskf_predict(eskf_state* me, float dt, const vec3f* ang_vel, const vec3f* accel)
+{
+	int n = me->n;
+
+	if(!me->initialized){
+		init_orientation(me, accel);
+		me->initialized = true;
+		return;
+	}
+
+	vec3f w;
+	ovec3f_subtract(ang_vel, &me->gyro_bias, &w);
+
+	vec3f w_dt = {{w.x * dt, w.y * dt, w.z * dt}};
+
+	// error state transition, F = I + A * dt
+	float F[N][N] = {{0}};
+	for(int i = 0; i < n; i++)
+		F[i][i] = 1.0f;
+
+	float w_dt_x[3][3];
+	skew(&w_dt, w_dt_x);
+
+	for(int i = 0; i < 3; i++){
+		for(int j = 0; j < 3; j++)
+			F[IDX_THETA + i][IDX_THETA + j] -= w_dt_x[i][j];
+
+		F[IDX_THETA + i][IDX_BIAS + i] = -dt;
+	}
+
+	if(me->flags & ESKF_FLAG_POSITION){
+		// d_vel' = -R * [a]x * d_theta, columns of R * [a]x are R * (a x e_j)
+		for(int j = 0; j < 3; j++){
+			vec3f e = {{0}}, a_x_e, col;
+			e.arr[j] = 1.0f;
+
+			a_x_e.x = accel->y * e.z - accel->z * e.y;
+			a_x_e.y = accel->z * e.x - accel->x * e.z;
+			a_x_e.z = accel->x * e.y - accel->y * e.x;
+
+			oquatf_get_rotated(&me->orient, &a_x_e, &col);
+
+			for(int i = 0; i < 3; i++)
+				F[IDX_VEL + i][IDX_THETA + j] = -col.arr[i] * dt;
+		}
+
+		for(int i = 0; i < 3; i++)
+			F[IDX_POS + i][IDX_VEL + i] = dt;
+
+		// nominal velocity and position with gravity removed
+		vec3f a_world;
+		oquatf_get_rotated(&me->orient, accel, &a_world);
+		a_world.y -= me->gravity;
+
+		for(int i = 0; i < 3; i++){
+			me->pos.arr[i] += me->vel.arr[i] * dt + 0.5f * a_world.arr[i] * dt * dt;
+			me->vel.arr[i] += a_world.arr[i] * dt;
+		}
+	}
+
+	// nominal orientation
+	quatf dq;
+	quat_from_rotvec(&w_dt, &dq);
+	oquatf_mult_me(&me->orient, &dq);
+	oquatf_normalize_me(&me->orient);
+
+	// P = F * P * F^T + Q
+	float FP[N][N];
+	for(int i = 0; i < n; i++){
+		for(int j = 0; j < n; j++){
+			float s = 0;
+			for(int k = 0; k < n; k++)
+				s += F[i][k] * me->P[k][j];
+			FP[i][j] = s;
+		}
+	}
+
+	for(int i = 0; i < n; i++){
+		for(int j = 0; j < n; j++){
+			float s = 0;
+			for(int k = 0; k < n; k++)
+				s += FP[i][k] * F[j][k];
+			me->P[i][j] = s;
+		}
+	}
+
+	for(int i = 0; i < 3; i++){
+		me->P[IDX_THETA + i][IDX_THETA + i] += POW2(me->gyro_noise) * dt;
+		me->P[IDX_BIAS + i][IDX_BIAS + i] += POW2(me->gyro_bias_noise) * dt;
+
+		if(me->flags & ESKF_FLAG_POSITION)
+			me->P[IDX_VEL + i][IDX_VEL + i] += POW2(me->accel_noise) * dt;
+	}
+
+	symmetrize(me);
+}
+
+bool oeskf_correct_gravity(eskf_state* me, const vec3f* accel, const vec3f* ang_vel)
+{
+	float accel_length = ovec3f_get_length(accel);
+
+	// reject samples dominated by linear acceleration
+	if(fabsf(accel_length - me->gravity) > me->gravity_gate)
+		return false;
+
+	vec3f z = {{accel->x / accel_length, accel->y / accel_length, accel->z / accel_length}};
+
+	// predicted gravity direction in the body frame, h = R^T * up
+	vec3f up = {{0, 1.0f, 0}}, h;
+	quatf inv;
+	quat_conj(&me->orient, &inv);
+	oquatf_get_rotated(&inv, &up, &h);
+
+	// H = [ [h]x 0 ... ]
+	float Hx[3][3];
+	skew(&h, Hx);
+
+	float PHt[N][3];
+	for(int i = 0; i < me->n; i++)
+		for(int j = 0; j < 3; j++)
+			PHt[i][j] = me->P[i][0] * Hx[j][0] + me->P[i][1] * Hx[j][1] + me->P[i][2] * Hx[j][2];
+
+	// trust the accelerometer less while rotating fast
+	float w = ang_vel ? ovec3f_get_length(ang_vel) : 0;
+	float r = POW2(me->gravity_noise) * (1.0f + 5.0f * w);
+
+	float S[3][3];
+	for(int i = 0; i < 3; i++){
+		for(int j = 0; j < 3; j++)
+			S[i][j] = Hx[i][0] * PHt[0][j] + Hx[i][1] * PHt[1][j] + Hx[i][2] * PHt[2][j];
+		S[i][i] += r;
+	}
+
+	vec3f y;
+	ovec3f_subtract(&z, &h, &y);
+
+	return correct3(me, PHt, S, &y);
+}
+
+void oeskf_correct_position(eskf_state* me, const vec3f* pos, float variance)
+{
+	if(!(me->flags & ESKF_FLAG_POSITION))
+		return;
+
+	float PHt[N][3], S[3][3];
+
+	for(int i = 0; i < me->n; i++)
+		for(int j = 0; j < 3; j++)
+			PHt[i][j] = me->P[i][IDX_POS + j];
+
+	for(int i = 0; i < 3; i++){
+		for(int j = 0; j < 3; j++)
+			S[i][j] = me->P[IDX_POS + i][IDX_POS + j];
+		S[i][i] += variance;
+	}
+
+	vec3f y;
+	ovec3f_subtract(pos, &me->pos, &y);
+
+	correct3(me, PHt, S, &y);
+}
+
+void oeskf_update(eskf_state* me, float dt, const vec3f* ang_vel, const vec3f* accel)
+{
+	bool was_initialized = me->initialized;
+
+	oeskf_predict(me, dt, ang_vel, accel);
+
+	if(was_initialized){
+		vec3f w;
+		ovec3f_subtract(ang_vel, &me->gyro_bias, &w);
+		oeskf_correct_gravity(me, accel, &w);
+	}
+}
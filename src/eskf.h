@@ -0,0 +1,51 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Error-State Kalman Filter */
+
+
+#ifndef ESKF_H
+#define ESKF_H
+
+#include <stdbool.h>
+#include "omath.h"
+
+// error state layout: [d_theta, d_gyro_bias, d_velocity, d_position]
+#define ESKF_ORIENT_STATES 6
+#define ESKF_MAX_STATES 12
+
+#define ESKF_FLAG_POSITION 1
+
+typedef struct {
+	int flags;
+	int n; // active error states, ESKF_ORIENT_STATES or ESKF_MAX_STATES
+	bool initialized;
+
+	// nominal state, orientation is body to world
+	quatf orient;
+	vec3f gyro_bias;
+	vec3f vel;
+	vec3f pos;
+
+	// error state covariance, only the top-left n x n block is used
+	float P[ESKF_MAX_STATES][ESKF_MAX_STATES];
+
+	// noise parameters (continuous time densities / measurement std devs)
+	float gyro_noise;       // rad/s/sqrt(Hz)
+	float gyro_bias_noise;  // rad/s^2/sqrt(Hz)
+	float accel_noise;      // m/s^2/sqrt(Hz)
+	float gravity_noise;    // std dev of the normalized accelerometer direction
+	float gravity_gate;     // max deviation of |accel| from g to accept a gravity update (m/s^2)
+	float gravity;          // m/s^2
+} eskf_state;
+
+void oeskf_init(eskf_state* me, int flags);
+void oeskf_predict(eskf_state* me, float dt, const vec3f* ang_vel, const vec3f* accel);
+bool oeskf_correct_gravity(eskf_state* me, const vec3f* accel, const vec3f* ang_vel);
+void oeskf_correct_position(eskf_state* me, const vec3f* pos, float variance);
+void oeskf_update(eskf_state* me, float dt, const vec3f* ang_vel, const vec3f* accel);
+
+#endif
@@ -0,0 +1,156 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Frame Pacing Implementation */
+
+/*
+ * The application reports when it begins rendering a frame, when it submits it
+ * and, if it knows, when it was presented. Every duration is kept as the median
+ * of a short window, so a single hitch or a missed vblank doesn't move the
+ * estimates. Present to present intervals spanning several vblanks are divided
+ * down to one period. Without presents the submit intervals stand in for the
+ * period and a frame is assumed to reach the display one period after submit.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "openhmdi.h"
+
+#define DEFAULT_DISPLAY_PERIOD (1.0 / 90.0)
+#define MAX_SKIPPED_PERIODS 4 // longer gaps are pauses, not missed vblanks
+#define MAX_FRAME_TIME 0.5    // longer durations are pauses too
+
+static void window_add(timing_window* me, double value)
+{
+	me->samples[me->at] = value;
+	me->at = (me->at + 1) % FRAME_TIMING_WINDOW;
+	if(me->count < FRAME_TIMING_WINDOW)
+		me->count++;
+}
+
+// median of the window, or fallback if it's empty
+static double window_median(const timing_window* me, double fallback)
+{
+	if(me->count == 0)
+		return fallback;
+
+	double sorted[FRAME_TIMING_WINDOW];
+	for(int i = 0; i < me->count; i++){
+		int j = i;
+		for(; j > 0 && sorted[j - 1] > me->samples[i]; j--)
+			sorted[j] = sorted[j - 1];
+		sorted[j] = me->samples[i];
+	}
+
+	return sorted[me->count / 2];
+}
+
+static void add_interval(frame_timing* me, double interval)
+{
+	if(interval <= 0 || interval > MAX_FRAME_TIME)
+		return;
+
+	// once the period is known an interval of n periods is n - 1 missed vblanks
+	if(me->period.count > 0){
+		double n = round(interval / oframe_timing_get_period(me));
+		if(n < 1 || n > MAX_SKIPPED_PERIODS)
+			return;
+		interval /= n;
+	}
+
+	window_add(&me->period, interval);
+}
+
+void oframe_timing_init(frame_timing* me)
+{
+	memset(me, 0, sizeof(frame_timing));
+	me->default_period = DEFAULT_DISPLAY_PERIOD;
+}
+
+void oframe_timing_begin(frame_timing* me, double time)
+{
+	me->frame_begin = time;
+	me->in_frame = true;
+}
+
+void oframe_timing_submit(frame_timing* me, double time)
+{
+	if(me->in_frame){
+		double render = time - me->frame_begin;
+		if(render >= 0 && render < MAX_FRAME_TIME)
+			window_add(&me->render, render);
+		me->in_frame = false;
+	}
+
+	if(me->have_submit && !me->have_present)
+		add_interval(me, time - me->last_submit);
+
+	me->last_submit = time;
+	me->have_submit = true;
+
+	// apps that never report presents would fill this up, drop the oldest then
+	if(me->num_pending == FRAME_TIMING_PENDING){
+		memmove(me->pending, me->pending + 1, sizeof(double) * (FRAME_TIMING_PENDING - 1));
+		me->num_pending--;
+	}
+	me->pending[me->num_pending++] = time;
+}
+
+void oframe_timing_present(frame_timing* me, double time)
+{
+	if(!me->have_present){
+		// the submit intervals were only a stand in
+		memset(&me->period, 0, sizeof(timing_window));
+	} else {
+		add_interval(me, time - me->last_present);
+	}
+
+	me->last_present = time;
+	me->have_present = true;
+
+	// presents complete the oldest submitted frame
+	if(me->num_pending > 0){
+		double latency = time - me->pending[0];
+		if(latency >= 0 && latency < MAX_FRAME_TIME)
+			window_add(&me->latency, latency);
+
+		me->num_pending--;
+		memmove(me->pending, me->pending + 1, sizeof(double) * me->num_pending);
+	}
+}
+
+double oframe_timing_get_period(const frame_timing* me)
+{
+	return window_median(&me->period, me->default_period);
+}
+
+double oframe_timing_get_render_time(const frame_timing* me)
+{
+	return window_median(&me->render, 0);
+}
+
+double oframe_timing_get_latency(const frame_timing* me)
+{
+	return window_median(&me->latency, oframe_timing_get_period(me));
+}
+
+double oframe_timing_predict(const frame_timing* me, double now)
+{
+	double start = me->in_frame ? me->frame_begin : now;
+	double period = oframe_timing_get_period(me);
+	double ready = start + oframe_timing_get_render_time(me);
+	double display = ready + oframe_timing_get_latency(me);
+
+	if(!me->have_present)
+		return display;
+
+	// land on the vblank grid, but never before the frame can be done
+	double t = me->last_present + round((display - me->last_present) / period) * period;
+	while(t < ready)
+		t += period;
+
+	return t;
+}
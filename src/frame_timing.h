@@ -0,0 +1,54 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Frame Pacing */
+
+
+#ifndef FRAME_TIMING_H
+#define FRAME_TIMING_H
+
+#include <stdbool.h>
+
+#define FRAME_TIMING_WINDOW 15 // samples per median, odd
+#define FRAME_TIMING_PENDING 4 // submitted frames waiting for their present
+
+typedef struct {
+	double samples[FRAME_TIMING_WINDOW];
+	int count, at;
+} timing_window;
+
+typedef struct {
+	timing_window period;  // display period, s
+	timing_window render;  // frame begin to submit, s
+	timing_window latency; // submit to present, s
+
+	double frame_begin;  // begin of the frame being rendered, valid if in_frame
+	bool in_frame;
+
+	double last_submit;  // valid if have_submit
+	bool have_submit;
+
+	double last_present; // valid if have_present
+	bool have_present;
+
+	// submit times of frames not presented yet, oldest first
+	double pending[FRAME_TIMING_PENDING];
+	int num_pending;
+
+	double default_period; // s, used until the period has been measured
+} frame_timing;
+
+void oframe_timing_init(frame_timing* me);
+void oframe_timing_begin(frame_timing* me, double time);
+void oframe_timing_submit(frame_timing* me, double time);
+void oframe_timing_present(frame_timing* me, double time);
+
+double oframe_timing_get_period(const frame_timing* me);
+double oframe_timing_get_render_time(const frame_timing* me);
+double oframe_timing_get_latency(const frame_timing* me);
+double oframe_timing_predict(const frame_timing* me, double now);
+
+#endif
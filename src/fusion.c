@@ -22,6 +22,61 @@ void ofusion_init(fusion* me)
 
 	me->flags = FF_USE_GRAVITY;
 	me->grav_gain = 0.05f;
+
+	me->engine = FUSION_ENGINE_COMPLEMENTARY;
+}
+
+void ofusion_set_engine(fusion* me, fusion_engine engine)
+{
+	if(me->engine == engine)
+		return;
+
+	me->engine = engine;
+
+	if(engine == FUSION_ENGINE_ESKF){
+		oeskf_init(&me->eskf, 0);
+
+		// start from the current estimate if the filter is already running
+		if(me->iterations > 0){
+			me->eskf.orient = me->orient;
+			me->eskf.initialized = true;
+		}
+	}
+}
+
+static void ofusion_update_eskf(fusion* me, float dt, const vec3f* ang_vel, const vec3f* accel)
+{
+	oeskf_update(&me->eskf, dt, ang_vel, accel);
+
+	me->orient = me->eskf.orient;
+
+	// report the bias corrected angular velocity
+	ovec3f_subtract(ang_vel, &me->eskf.gyro_bias, &me->ang_vel);
+}
+
+// Set the host time of the next sample, for drivers that map the device clock
+void ofusion_set_sample_time(fusion* me, double time)
+{
+	me->sample_time = time;
+	me->sample_time_set = true;
+}
+
+// Unless the driver provided it, advance the host timestamp by the device dt,
+// pulling it back to the arrival time if it runs ahead of it or falls too far
+// behind (dropped reports).
+static void update_sample_time(fusion* me, float dt)
+{
+	if(me->sample_time_set){
+		me->sample_time_set = false;
+		return;
+	}
+
+	double now = ohmd_get_tick();
+
+	me->sample_time += dt;
+
+	if(me->sample_time > now || now - me->sample_time > 0.05)
+		me->sample_time = now;
 }
 
 void ofusion_update(fusion* me, float dt, const vec3f* ang_vel, const vec3f* accel, const vec3f* mag)
@@ -42,6 +97,21 @@ void ofusion_update(fusion* me, float dt, const vec3f* ang_vel, const vec3f* acc
 	ofq_add(&me->accel_fq, &world_accel);
 	ofq_add(&me->ang_vel_fq, ang_vel);
 
+	update_sample_time(me, dt);
+
+	if(me->preint){
+		vec3f gyro = *ang_vel;
+		if(me->engine == FUSION_ENGINE_ESKF)
+			ovec3f_subtract(ang_vel, &me->eskf.gyro_bias, &gyro);
+
+		opreint_add(me->preint, me->sample_time, dt, &gyro, accel);
+	}
+
+	if(me->engine == FUSION_ENGINE_ESKF){
+		ofusion_update_eskf(me, dt, ang_vel, accel);
+		return;
+	}
+
 	float ang_vel_length = ovec3f_get_length(ang_vel);
 
 	if(ang_vel_length > 0.0001f){
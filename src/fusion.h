@@ -12,9 +12,16 @@
 #define FUSION_H
 
 #include "omath.h"
+#include "eskf.h"
+#include "preint.h"
 
 #define FF_USE_GRAVITY 1
 
+typedef enum {
+	FUSION_ENGINE_COMPLEMENTARY = 0,
+	FUSION_ENGINE_ESKF = 1,
+} fusion_engine;
+
 typedef struct {
 	int state;
 
@@ -37,9 +44,22 @@ typedef struct {
 	float grav_error_angle;
 	vec3f grav_error_axis;
 	float grav_gain; // amount of correction
+
+	// error-state kalman filter, used instead of the above when selected
+	fusion_engine engine;
+	eskf_state eskf;
+
+	// host time of the last sample, seconds
+	double sample_time;
+	bool sample_time_set;
+
+	// optional pre-integration buffer, owned by the core
+	imu_preint* preint;
 } fusion;
 
 void ofusion_init(fusion* me);
+void ofusion_set_engine(fusion* me, fusion_engine engine);
+void ofusion_set_sample_time(fusion* me, double time);
 void ofusion_update(fusion* me, float dt, const vec3f* ang_vel, const vec3f* accel, const vec3f* mag_field);
 
 #endif
@@ -0,0 +1,93 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Fixed Size Object Pool Implementation */
+
+#include <string.h>
+#include "openhmdi.h"
+
+#define POOL_ALIGN 16 // enough for any type the drivers keep in a pool
+
+static size_t align_up(size_t size)
+{
+	return (size + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1);
+}
+
+void omem_pool_init(mem_pool* me, ohmd_context* ctx, size_t size, int per_chunk)
+{
+	memset(me, 0, sizeof(mem_pool));
+
+	me->ctx = ctx;
+	me->size = align_up(size < sizeof(void*) ? sizeof(void*) : size);
+	me->per_chunk = per_chunk > 0 ? per_chunk : 1;
+}
+
+void omem_pool_destroy(mem_pool* me)
+{
+	void* chunk = me->chunks;
+	while(chunk){
+		void* next = *(void**)chunk;
+		free(chunk);
+		chunk = next;
+	}
+
+	me->chunks = NULL;
+	me->free_list = NULL;
+	me->num_free = me->num_objects = 0;
+}
+
+static bool add_chunk(mem_pool* me, int count)
+{
+	// the chunk header is padded so the objects stay aligned
+	char* chunk = ohmd_alloc(me->ctx, align_up(sizeof(void*)) + me->size * count);
+	if(!chunk)
+		return false;
+
+	*(void**)chunk = me->chunks;
+	me->chunks = chunk;
+
+	char* obj = chunk + align_up(sizeof(void*));
+	for(int i = 0; i < count; i++, obj += me->size){
+		*(void**)obj = me->free_list;
+		me->free_list = obj;
+	}
+
+	me->num_free += count;
+	me->num_objects += count;
+
+	return true;
+}
+
+bool omem_pool_reserve(mem_pool* me, int count)
+{
+	if(me->num_free >= count)
+		return true;
+
+	return add_chunk(me, count - me->num_free);
+}
+
+void* omem_pool_alloc(mem_pool* me)
+{
+	if(!me->free_list && !add_chunk(me, me->per_chunk))
+		return NULL;
+
+	void* obj = me->free_list;
+	me->free_list = *(void**)obj;
+	me->num_free--;
+
+	memset(obj, 0, me->size);
+	return obj;
+}
+
+void omem_pool_free(mem_pool* me, void* obj)
+{
+	if(!obj)
+		return;
+
+	*(void**)obj = me->free_list;
+	me->free_list = obj;
+	me->num_free++;
+}
@@ -0,0 +1,39 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Fixed Size Object Pool */
+
+
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "openhmd.h"
+
+// objects of one size recycled through a free list, the heap is only used to add chunks
+typedef struct {
+	ohmd_context* ctx;
+	size_t size;       // object size, rounded up to the alignment
+	int per_chunk;     // objects added when the free list runs out
+	void* free_list;
+	void* chunks;      // linked through their first pointer
+	int num_free, num_objects;
+} mem_pool;
+
+void omem_pool_init(mem_pool* me, ohmd_context* ctx, size_t size, int per_chunk);
+
+// frees all chunks, every object handed out becomes invalid
+void omem_pool_destroy(mem_pool* me);
+
+// makes sure count objects can be allocated without touching the heap
+bool omem_pool_reserve(mem_pool* me, int count);
+
+// returns a zeroed object, or NULL with the context error set
+void* omem_pool_alloc(mem_pool* me);
+void omem_pool_free(mem_pool* me, void* obj);
+
+#endif
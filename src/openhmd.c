@@ -10,106 +10,352 @@
 
 #include "openhmdi.h"
 #include "shaders.h"
+#if DRIVER_SHM
+#include "drv_shm/shm.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
 // Running automatic updates at 1000 Hz
 #define AUTOMATIC_UPDATE_SLEEP (1.0 / 1000.0)
+#define MAX_TIMEWARP_PREDICTION 0.1 // seconds, further ahead the extrapolation is worse than none
+#define CONTROL_EVENT_QUEUE_LEN 256 // per device, see ohmd_device_get_control_events
+#define OPEN_ERROR_SIZE (OHMD_STR_SIZE * 3) // fits the product and path of the device
 
-OHMD_APIENTRYDLL ohmd_context* OHMD_APIENTRY ohmd_ctx_create(void)
+void ohmd_add_driver(ohmd_context* ctx, ohmd_driver* driver)
 {
-	ohmd_context* ctx = calloc(1, sizeof(ohmd_context));
-	if(!ctx){
-		LOGE("could not allocate RAM for context");
-		return NULL;
+	if(!driver)
+		return;
+
+	driver->open_mutex = ohmd_create_mutex(ctx);
+	driver->group_mutex = ohmd_create_mutex(ctx);
+
+	if(ohmd_grow(ctx, (void**)&ctx->drivers, &ctx->drivers_capacity, ctx->num_drivers + 1, sizeof(ohmd_driver*))){
+		ctx->drivers[ctx->num_drivers++] = driver;
+	} else {
+		if(driver->open_mutex)
+			ohmd_destroy_mutex(driver->open_mutex);
+		if(driver->group_mutex)
+			ohmd_destroy_mutex(driver->group_mutex);
+		driver->destroy(driver);
 	}
+}
 
-	ohmd_monotonic_init(ctx);
-
+// compiled in drivers by the names OHMD_DRIVERS selects them with, in order of priority
+static const struct {
+	const char* name;
+	ohmd_driver* (*create)(ohmd_context* ctx);
+} builtin_drivers[] = {
 #if DRIVER_OCULUS_RIFT
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_oculus_rift_drv(ctx);
+	{ "rift", ohmd_create_oculus_rift_drv },
 #endif
-
 #if DRIVER_OCULUS_RIFT_S
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_oculus_rift_s_drv(ctx);
+	{ "rift-s", ohmd_create_oculus_rift_s_drv },
 #endif
-
 #if DRIVER_DEEPOON
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_deepoon_drv(ctx);
+	{ "deepoon", ohmd_create_deepoon_drv },
 #endif
-
 #if DRIVER_HTC_VIVE
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_htc_vive_drv(ctx);
+	{ "vive", ohmd_create_htc_vive_drv },
 #endif
-
 #if DRIVER_WMR
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_wmr_drv(ctx);
+	{ "wmr", ohmd_create_wmr_drv },
 #endif
-
 #if DRIVER_PSVR
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_psvr_drv(ctx);
+	{ "psvr", ohmd_create_psvr_drv },
 #endif
-
 #if DRIVER_NOLO
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_nolo_drv(ctx);
+	{ "nolo", ohmd_create_nolo_drv },
 #endif
-
 #if DRIVER_XGVR
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_xgvr_drv(ctx);
+	{ "xgvr", ohmd_create_xgvr_drv },
 #endif
-
 #if DRIVER_VRTEK
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_vrtek_drv(ctx);
+	{ "vrtek", ohmd_create_vrtek_drv },
 #endif
-
 #if DRIVER_ANDROID
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_android_drv(ctx);
+	{ "android", ohmd_create_android_drv },
 #endif
-
 #if DRIVER_EXTERNAL
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_external_drv(ctx);
+	{ "external", ohmd_create_external_drv },
+#endif
+#if DRIVER_SHM
+	{ "shm", ohmd_create_shm_drv },
 #endif
+	{ NULL, NULL }
+};
+
+OHMD_APIENTRYDLL ohmd_context* OHMD_APIENTRY ohmd_ctx_create(void)
+{
+	ohmd_context* ctx = calloc(1, sizeof(ohmd_context));
+	if(!ctx){
+		LOGE("could not allocate RAM for context");
+		return NULL;
+	}
+
+	ohmd_monotonic_init(ctx);
+	ctx->list.ctx = ctx;
+
+	// devices may be opened from other threads, see ohmd_list_open_device_async
+	ctx->update_mutex = ohmd_create_mutex(ctx);
+
+	for(int i = 0; builtin_drivers[i].name; i++){
+		if(oplugin_driver_allowed(builtin_drivers[i].name))
+			ohmd_add_driver(ctx, builtin_drivers[i].create(ctx));
+	}
+
+	oplugin_load_all(ctx);
+
 	// add dummy driver last to make it the lowest priority
-	ctx->drivers[ctx->num_drivers++] = ohmd_create_dummy_drv(ctx);
+	if(oplugin_driver_allowed("dummy"))
+		ohmd_add_driver(ctx, ohmd_create_dummy_drv(ctx));
 
 	ctx->update_request_quit = false;
 
 	return ctx;
 }
 
+// frees what the core attached to an open device, then has the driver close it
+static void destroy_device(ohmd_device* device)
+{
+	if(device->fusion && device->fusion->preint){
+		free(device->fusion->preint);
+		device->fusion->preint = NULL;
+	}
+
+	odistortion_mesh_free(&device->distortion_mesh[OHMD_EYE_LEFT]);
+	odistortion_mesh_free(&device->distortion_mesh[OHMD_EYE_RIGHT]);
+	for(int i = 0; i < 2; i++){
+		odistortion_area_free(&device->distortion_area[i][OHMD_EYE_LEFT]);
+		odistortion_area_free(&device->distortion_area[i][OHMD_EYE_RIGHT]);
+	}
+
+	// drivers share state between the devices of one connection, don't race a concurrent open,
+	// nor the unlocked update of a group that decodes into this device and pushes to its queue
+	ohmd_driver* driver = (ohmd_driver*)device->desc.driver_ptr;
+	ohmd_lock_mutex(driver->open_mutex);
+	ohmd_lock_mutex(driver->group_mutex);
+
+	ospsc_queue_destroy(&device->control_events);
+	device->close(device);
+
+	ohmd_unlock_mutex(driver->group_mutex);
+	ohmd_unlock_mutex(driver->open_mutex);
+}
+
 OHMD_APIENTRYDLL void OHMD_APIENTRY ohmd_ctx_destroy(ohmd_context* ctx)
 {
 	ctx->update_request_quit = true;
 
 	for(int i = 0; i < ctx->num_active_devices; i++){
-		ctx->active_devices[i]->close(ctx->active_devices[i]);
+		destroy_device(ctx->active_devices[i]);
 	}
 
 	for(int i = 0; i < ctx->num_drivers; i++){
+		ohmd_mutex* open_mutex = ctx->drivers[i]->open_mutex;
+		ohmd_mutex* group_mutex = ctx->drivers[i]->group_mutex;
 		ctx->drivers[i]->destroy(ctx->drivers[i]);
+		if(open_mutex)
+			ohmd_destroy_mutex(open_mutex);
+		if(group_mutex)
+			ohmd_destroy_mutex(group_mutex);
 	}
 
-	if(ctx->update_thread){
+	oplugin_unload_all(ctx);
+
+#if DRIVER_SHM
+	if(ctx->shm_server)
+		oshm_server_destroy(ctx->shm_server);
+#endif
+
+	if(ctx->update_thread)
 		ohmd_destroy_thread(ctx->update_thread);
+
+	if(ctx->update_mutex)
 		ohmd_destroy_mutex(ctx->update_mutex);
-	}
 
+	if(ctx->update_pool)
+		oworker_pool_destroy(ctx->update_pool);
+
+	free(ctx->drivers);
+	free(ctx->list.devices);
+	free(ctx->active_devices);
+	free(ctx->update_order);
+	free(ctx->update_groups);
+	free(ctx->update_group_drivers);
 	free(ctx);
 }
 
+static bool is_manual(const ohmd_device* dev)
+{
+	return !dev->settings.automatic_update && dev->update;
+}
+
+// drivers share state between the devices of one connection (a headset and its controllers), those must not update concurrently
+static bool same_connection(const ohmd_device* a, const ohmd_device* b)
+{
+	return a->desc.driver_ptr == b->desc.driver_ptr && strcmp(a->desc.path, b->desc.path) == 0;
+}
+
+static bool build_update_groups(ohmd_context* ctx)
+{
+	int n = ctx->num_active_devices;
+
+	if(!ohmd_grow(ctx, (void**)&ctx->update_order, &ctx->update_order_capacity, n, sizeof(ohmd_device*)) ||
+	   !ohmd_grow(ctx, (void**)&ctx->update_groups, &ctx->update_groups_capacity, n + 1, sizeof(int)) ||
+	   !ohmd_grow(ctx, (void**)&ctx->update_group_drivers, &ctx->update_group_drivers_capacity, n, sizeof(ohmd_driver*)))
+		return false;
+
+	int count = 0;
+	ctx->num_update_groups = 0;
+
+	for(int i = 0; i < n; i++){
+		ohmd_device* dev = ctx->active_devices[i];
+		if(!is_manual(dev))
+			continue;
+
+		// already placed with the first device of its connection
+		bool placed = false;
+		for(int k = 0; k < i && !placed; k++)
+			placed = is_manual(ctx->active_devices[k]) && same_connection(ctx->active_devices[k], dev);
+		if(placed)
+			continue;
+
+		ctx->update_group_drivers[ctx->num_update_groups] = (ohmd_driver*)dev->desc.driver_ptr;
+		ctx->update_groups[ctx->num_update_groups++] = count;
+		for(int j = i; j < n; j++){
+			if(is_manual(ctx->active_devices[j]) && same_connection(ctx->active_devices[j], dev))
+				ctx->update_order[count++] = ctx->active_devices[j];
+		}
+	}
+
+	ctx->update_groups[ctx->num_update_groups] = count;
+	ctx->update_groups_dirty = false;
+	ctx->update_groups_closes = ohmd_atomic_load(&ctx->num_closes);
+
+	return true;
+}
+
+void ohmd_device_report_controls(ohmd_device* device, double device_time, double host_time)
+{
+	if(!device->control_events.entries)
+		return;
+
+	// drivers may only fill in some of the controls
+	float values[OHMD_MAX_CONTROLS];
+	memcpy(values, device->control_values, sizeof(values));
+	if(device->getf(device, OHMD_CONTROLS_STATE, values) != 0)
+		return;
+
+	int count = OHMD_MIN(device->properties.control_count, OHMD_MAX_CONTROLS);
+	for(int i = 0; i < count; i++){
+		if(values[i] == device->control_values[i])
+			continue;
+
+		// when full the change stays pending and is queued with the then current value once there's room
+		ohmd_control_event event = {host_time, device_time, i, values[i]};
+		if(!ospsc_queue_push(&device->control_events, &event))
+			return;
+
+		device->control_values[i] = values[i];
+	}
+}
+
+// also catches the control changes of drivers that don't report them while decoding, those
+// that do may decode on another update thread, a second producer would corrupt the queue
+static void update_device(ohmd_device* device)
+{
+	device->update(device);
+
+	if(device->control_events.entries && !device->reports_controls)
+		ohmd_device_report_controls(device, 0, ohmd_get_tick());
+}
+
+// runs without the update mutex, the group mutex keeps the devices of the group from closing meanwhile
+static void update_group(void* arg, int index)
+{
+	ohmd_context* ctx = (ohmd_context*)arg;
+	ohmd_driver* driver = ctx->update_group_drivers[index];
+
+	ohmd_lock_mutex(driver->group_mutex);
+
+	// a device closed since the groups were built may be gone, they are rebuilt by the next update
+	if(ohmd_atomic_load(&ctx->num_closes) == ctx->update_groups_closes){
+		for(int i = ctx->update_groups[index]; i < ctx->update_groups[index + 1]; i++)
+			update_device(ctx->update_order[i]);
+	}
+
+	ohmd_unlock_mutex(driver->group_mutex);
+}
+
 OHMD_APIENTRYDLL void OHMD_APIENTRY ohmd_ctx_update(ohmd_context* ctx)
 {
+	// background opens add devices at any time, the groups only hold device pointers so they may run unlocked
+	ohmd_lock_mutex(ctx->update_mutex);
+
+	bool grouped = !ctx->update_groups_dirty || build_update_groups(ctx);
+	if(!grouped){
+		// out of memory, update everything here
+		for(int i = 0; i < ctx->num_active_devices; i++){
+			if(is_manual(ctx->active_devices[i]))
+				update_device(ctx->active_devices[i]);
+		}
+	}
+
+	ohmd_unlock_mutex(ctx->update_mutex);
+
+	if(grouped && ctx->update_pool){
+		oworker_pool_run(ctx->update_pool, update_group, ctx, ctx->num_update_groups);
+	} else if(grouped){
+		for(int i = 0; i < ctx->num_update_groups; i++)
+			update_group(ctx, i);
+	}
+
+	// the poses of all devices are taken under one lock
+	ohmd_lock_mutex(ctx->update_mutex);
+
+	double now = ohmd_get_tick();
 	for(int i = 0; i < ctx->num_active_devices; i++){
 		ohmd_device* dev = ctx->active_devices[i];
-		if(!dev->settings.automatic_update && dev->update)
-			dev->update(dev);
-
-		ohmd_lock_mutex(ctx->update_mutex);
 		dev->getf(dev, OHMD_POSITION_VECTOR, (float*)&dev->position);
 		dev->getf(dev, OHMD_ROTATION_QUAT, (float*)&dev->rotation);
-		ohmd_unlock_mutex(ctx->update_mutex);
+
+#if DRIVER_SHM
+		// clients apply their own filters and corrections
+		if(ctx->shm_server)
+			oshm_server_publish(ctx->shm_server, dev);
+#endif
+
+		opose_filter_position(&dev->pose_filter, now, &dev->position);
+		opose_filter_rotation(&dev->pose_filter, now, &dev->rotation);
 	}
+
+	ohmd_unlock_mutex(ctx->update_mutex);
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_ctx_set_update_threads(ohmd_context* ctx, int count)
+{
+	if(count < 1){
+		ohmd_set_error(ctx, "invalid update thread count: %d", count);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	if(ctx->update_pool){
+		oworker_pool_destroy(ctx->update_pool);
+		ctx->update_pool = NULL;
+	}
+
+	if(count == 1)
+		return OHMD_S_OK;
+
+	ctx->update_pool = oworker_pool_create(ctx, count);
+	if(!ctx->update_pool){
+		ohmd_set_error(ctx, "could not start %d update threads", count);
+		return OHMD_S_UNKNOWN_ERROR;
+	}
+
+	return OHMD_S_OK;
 }
 
 OHMD_APIENTRYDLL const char* OHMD_APIENTRY ohmd_ctx_get_error(ohmd_context* ctx)
@@ -119,7 +365,7 @@ OHMD_APIENTRYDLL const char* OHMD_APIENTRY ohmd_ctx_get_error(ohmd_context* ctx)
 
 OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_ctx_probe(ohmd_context* ctx)
 {
-	memset(&ctx->list, 0, sizeof(ohmd_device_list));
+	ctx->list.num_devices = 0;
 	for(int i = 0; i < ctx->num_drivers; i++){
 		ctx->drivers[i]->get_device_list(ctx->drivers[i], &ctx->list);
 	}
@@ -127,6 +373,33 @@ OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_ctx_probe(ohmd_context* ctx)
 	return ctx->list.num_devices;
 }
 
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_ctx_publish(ohmd_context* ctx, const char* name)
+{
+#if DRIVER_SHM
+	ohmd_status ret = OHMD_S_OK;
+
+	ohmd_lock_mutex(ctx->update_mutex);
+
+	if(ctx->shm_server){
+		oshm_server_destroy(ctx->shm_server);
+		ctx->shm_server = NULL;
+	}
+
+	if(name){
+		ctx->shm_server = oshm_server_create(ctx, *name ? name : SHM_DEFAULT_NAME);
+		if(!ctx->shm_server)
+			ret = OHMD_S_UNKNOWN_ERROR;
+	}
+
+	ohmd_unlock_mutex(ctx->update_mutex);
+
+	return ret;
+#else
+	ohmd_set_error(ctx, "shared memory publishing is not supported by this build");
+	return OHMD_S_UNSUPPORTED;
+#endif
+}
+
 OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_gets(ohmd_string_description type, const char ** out)
 {
 	switch(type){
@@ -148,6 +421,42 @@ OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_gets(ohmd_string_description type, const
 	case OHMD_GLSL_ES_DISTORTION_FRAG_SRC:
 		*out = distortion_frag_es;
 		return OHMD_S_OK;
+	case OHMD_GLSL_MESH_DISTORTION_VERT_SRC:
+		*out = mesh_distortion_vert;
+		return OHMD_S_OK;
+	case OHMD_GLSL_MESH_DISTORTION_FRAG_SRC:
+		*out = mesh_distortion_frag;
+		return OHMD_S_OK;
+	case OHMD_GLSL_330_MESH_DISTORTION_VERT_SRC:
+		*out = mesh_distortion_vert_330;
+		return OHMD_S_OK;
+	case OHMD_GLSL_330_MESH_DISTORTION_FRAG_SRC:
+		*out = mesh_distortion_frag_330;
+		return OHMD_S_OK;
+	case OHMD_GLSL_ES_MESH_DISTORTION_VERT_SRC:
+		*out = mesh_distortion_vert_es;
+		return OHMD_S_OK;
+	case OHMD_GLSL_ES_MESH_DISTORTION_FRAG_SRC:
+		*out = mesh_distortion_frag_es;
+		return OHMD_S_OK;
+	case OHMD_GLSL_MAP_DISTORTION_FRAG_SRC:
+		*out = map_distortion_frag;
+		return OHMD_S_OK;
+	case OHMD_GLSL_330_MAP_DISTORTION_FRAG_SRC:
+		*out = map_distortion_frag_330;
+		return OHMD_S_OK;
+	case OHMD_GLSL_ES_MAP_DISTORTION_FRAG_SRC:
+		*out = map_distortion_frag_es;
+		return OHMD_S_OK;
+	case OHMD_GLSL_MESH_TIMEWARP_VERT_SRC:
+		*out = mesh_timewarp_vert;
+		return OHMD_S_OK;
+	case OHMD_GLSL_330_MESH_TIMEWARP_VERT_SRC:
+		*out = mesh_timewarp_vert_330;
+		return OHMD_S_OK;
+	case OHMD_GLSL_ES_MESH_TIMEWARP_VERT_SRC:
+		*out = mesh_timewarp_vert_es;
+		return OHMD_S_OK;
 	default:
 		return OHMD_S_UNSUPPORTED;
 	}
@@ -155,7 +464,7 @@ OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_gets(ohmd_string_description type, const
 
 OHMD_APIENTRYDLL const char* OHMD_APIENTRY ohmd_list_gets(ohmd_context* ctx, int index, ohmd_string_value type)
 {
-	if(index >= ctx->list.num_devices)
+	if(index < 0 || index >= ctx->list.num_devices)
 		return NULL;
 
 	switch(type){
@@ -172,7 +481,7 @@ OHMD_APIENTRYDLL const char* OHMD_APIENTRY ohmd_list_gets(ohmd_context* ctx, int
 
 OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_list_geti(ohmd_context* ctx, int index, ohmd_int_value type, int* out)
 {
-	if(index >= ctx->list.num_devices)
+	if(index < 0 || index >= ctx->list.num_devices)
 		return OHMD_S_INVALID_PARAMETER;
 
 	switch(type){
@@ -199,7 +508,7 @@ static unsigned int ohmd_update_thread(void* arg)
 
 		for(int i = 0; i < ctx->num_active_devices; i++){
 			if(ctx->active_devices[i]->settings.automatic_update && ctx->active_devices[i]->update)
-				ctx->active_devices[i]->update(ctx->active_devices[i]);
+				update_device(ctx->active_devices[i]);
 		}
 
 		ohmd_unlock_mutex(ctx->update_mutex);
@@ -210,61 +519,210 @@ static unsigned int ohmd_update_thread(void* arg)
 	return 0;
 }
 
+// called with the update mutex held
 static void ohmd_set_up_update_thread(ohmd_context* ctx)
 {
-	if(!ctx->update_thread){
-		ctx->update_mutex = ohmd_create_mutex(ctx);
+	if(!ctx->update_thread)
 		ctx->update_thread = ohmd_create_thread(ctx, ohmd_update_thread, ctx);
-	}
 }
 
-OHMD_APIENTRYDLL ohmd_device* OHMD_APIENTRY ohmd_list_open_device_s(ohmd_context* ctx, int index, ohmd_device_settings* settings)
+static void default_device_settings(ohmd_device_settings* settings)
 {
-	ohmd_lock_mutex(ctx->update_mutex);
+	settings->automatic_update = true;
+	settings->fusion_engine = OHMD_FUSION_ENGINE_COMPLEMENTARY;
+	settings->imu_preintegration = false;
+}
+
+// the slow part runs without the update mutex, so other devices keep updating meanwhile,
+// a failure is described in error as this may run on the thread of a background open
+static ohmd_device* open_device(ohmd_context* ctx, const ohmd_device_desc* listed, const ohmd_device_settings* settings, char* error)
+{
+	ohmd_device_desc desc = *listed;
+	ohmd_driver* driver = (ohmd_driver*)desc.driver_ptr;
+
+	ohmd_lock_mutex(driver->open_mutex);
+	ohmd_device* device = driver->open_device(driver, &desc);
+	ohmd_unlock_mutex(driver->open_mutex);
+
+	if (device == NULL) {
+		snprintf(error, OPEN_ERROR_SIZE, "Could not open device %s (%s), check device permissions?", desc.product, desc.path);
+		return NULL;
+	}
 
-	if(index >= 0 && index < ctx->list.num_devices){
+	device->rotation_correction.w = 1;
+	device->desc = desc;
+	opose_filter_init(&device->pose_filter);
+	oframe_timing_init(&device->frame_timing);
 
-		ohmd_device_desc* desc = &ctx->list.devices[index];
-		ohmd_driver* driver = (ohmd_driver*)desc->driver_ptr;
-		ohmd_device* device = driver->open_device(driver, desc);
+	device->settings = *settings;
 
-		if (device == NULL) {
-			ohmd_set_error(ctx, "Could not open device with index: %d, check device permissions?", index);
-			ohmd_unlock_mutex(ctx->update_mutex);
-			return NULL;
+	if(device->fusion){
+		ofusion_set_engine(device->fusion, (fusion_engine)device->settings.fusion_engine);
+
+		if(device->settings.imu_preintegration && !device->fusion->preint){
+			device->fusion->preint = ohmd_alloc(ctx, sizeof(imu_preint));
+			if(device->fusion->preint)
+				opreint_init(device->fusion->preint);
 		}
+	}
 
-		device->rotation_correction.w = 1;
+	device->ctx = ctx;
 
-		device->settings = *settings;
+	ohmd_lock_mutex(ctx->update_mutex);
 
-		device->ctx = ctx;
-		device->active_device_idx = ctx->num_active_devices;
-		ctx->active_devices[ctx->num_active_devices++] = device;
+	// drivers sharing a connection between devices queue into it from the update of another device
+	memset(device->control_values, 0, sizeof(device->control_values));
+	if(device->properties.control_count > 0)
+		ospsc_queue_init(&device->control_events, ctx, sizeof(ohmd_control_event), CONTROL_EVENT_QUEUE_LEN);
 
+	if(!ohmd_grow(ctx, (void**)&ctx->active_devices, &ctx->active_devices_capacity, ctx->num_active_devices + 1, sizeof(ohmd_device*))){
+		ospsc_queue_destroy(&device->control_events);
 		ohmd_unlock_mutex(ctx->update_mutex);
+		free(device->fusion ? device->fusion->preint : NULL);
+		device->close(device);
+		snprintf(error, OPEN_ERROR_SIZE, "Could not add device %s (%s) to the open devices", desc.product, desc.path);
+		return NULL;
+	}
 
-		if(device->settings.automatic_update)
-			ohmd_set_up_update_thread(ctx);
+	device->active_device_idx = ctx->num_active_devices;
+	ctx->active_devices[ctx->num_active_devices++] = device;
+	ctx->update_groups_dirty = true;
 
-		return device;
-	}
+	if(device->settings.automatic_update)
+		ohmd_set_up_update_thread(ctx);
 
 	ohmd_unlock_mutex(ctx->update_mutex);
 
-	ohmd_set_error(ctx, "no device with index: %d", index);
-	return NULL;
+	return device;
+}
+
+OHMD_APIENTRYDLL ohmd_device* OHMD_APIENTRY ohmd_list_open_device_s(ohmd_context* ctx, int index, ohmd_device_settings* settings)
+{
+	if(index < 0 || index >= ctx->list.num_devices){
+		ohmd_set_error(ctx, "no device with index: %d", index);
+		return NULL;
+	}
+
+	char error[OPEN_ERROR_SIZE];
+	ohmd_device* device = open_device(ctx, &ctx->list.devices[index], settings, error);
+	if(!device)
+		ohmd_set_error(ctx, "%.*s", OHMD_STR_SIZE - 1, error);
+
+	return device;
 }
 
 OHMD_APIENTRYDLL ohmd_device* OHMD_APIENTRY ohmd_list_open_device(ohmd_context* ctx, int index)
 {
 	ohmd_device_settings settings;
-
-	settings.automatic_update = true;
+	default_device_settings(&settings);
 
 	return ohmd_list_open_device_s(ctx, index, &settings);
 }
 
+struct ohmd_open_request {
+	ohmd_context* ctx;
+	ohmd_device_desc desc;
+	ohmd_device_settings settings;
+
+	ohmd_open_callback callback;
+	void* user_data;
+
+	ohmd_thread* thread;
+	ohmd_mutex* mutex; // protects state, device and error_msg
+	ohmd_open_state state;
+	ohmd_device* device;
+	char error_msg[OPEN_ERROR_SIZE];
+};
+
+static unsigned int open_request_thread(void* arg)
+{
+	ohmd_open_request* req = (ohmd_open_request*)arg;
+	char error[OPEN_ERROR_SIZE];
+	ohmd_device* device = open_device(req->ctx, &req->desc, &req->settings, error);
+	ohmd_open_state state = device ? OHMD_OPEN_READY : OHMD_OPEN_FAILED;
+
+	// the context error belongs to the application threads
+	if(!device)
+		LOGE("%s", error);
+
+	ohmd_lock_mutex(req->mutex);
+	req->device = device;
+	req->state = state;
+	if(!device)
+		strcpy(req->error_msg, error);
+	ohmd_unlock_mutex(req->mutex);
+
+	if(req->callback)
+		req->callback(req, state, device, req->user_data);
+
+	return 0;
+}
+
+OHMD_APIENTRYDLL ohmd_open_request* OHMD_APIENTRY ohmd_list_open_device_async(ohmd_context* ctx, int index, ohmd_device_settings* settings,
+	ohmd_open_callback callback, void* user_data)
+{
+	if(index < 0 || index >= ctx->list.num_devices){
+		ohmd_set_error(ctx, "no device with index: %d", index);
+		return NULL;
+	}
+
+	ohmd_open_request* req = ohmd_alloc(ctx, sizeof(ohmd_open_request));
+	if(!req)
+		return NULL;
+
+	req->ctx = ctx;
+	req->desc = ctx->list.devices[index];
+	req->callback = callback;
+	req->user_data = user_data;
+	req->state = OHMD_OPEN_PENDING;
+
+	if(settings)
+		req->settings = *settings;
+	else
+		default_device_settings(&req->settings);
+
+	req->mutex = ohmd_create_mutex(ctx);
+	if(req->mutex)
+		req->thread = ohmd_create_thread(ctx, open_request_thread, req);
+
+	if(!req->thread){
+		ohmd_set_error(ctx, "could not start a thread to open device with index: %d", index);
+		if(req->mutex)
+			ohmd_destroy_mutex(req->mutex);
+		free(req);
+		return NULL;
+	}
+
+	return req;
+}
+
+OHMD_APIENTRYDLL ohmd_open_state OHMD_APIENTRY ohmd_open_request_poll(ohmd_open_request* req, ohmd_device** device)
+{
+	ohmd_lock_mutex(req->mutex);
+	ohmd_open_state state = req->state;
+	if(device)
+		*device = req->device;
+	ohmd_unlock_mutex(req->mutex);
+
+	return state;
+}
+
+OHMD_APIENTRYDLL const char* OHMD_APIENTRY ohmd_open_request_get_error(ohmd_open_request* req)
+{
+	ohmd_lock_mutex(req->mutex);
+	const char* error = req->error_msg;
+	ohmd_unlock_mutex(req->mutex);
+
+	return error;
+}
+
+OHMD_APIENTRYDLL void OHMD_APIENTRY ohmd_open_request_destroy(ohmd_open_request* req)
+{
+	ohmd_destroy_thread(req->thread);
+	ohmd_destroy_mutex(req->mutex);
+	free(req);
+}
+
 OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_close_device(ohmd_device* device)
 {
 	ohmd_lock_mutex(device->ctx->update_mutex);
@@ -272,15 +730,19 @@ OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_close_device(ohmd_device* device)
 	ohmd_context* ctx = device->ctx;
 	int idx = device->active_device_idx;
 
-	memmove(ctx->active_devices + idx, ctx->active_devices + idx + 1,
-		sizeof(ohmd_device*) * (ctx->num_active_devices - idx - 1));
-
-	device->close(device);
+	// swap the last device into the gap, the update order doesn't matter
+	ohmd_device* last = ctx->active_devices[--ctx->num_active_devices];
+	ctx->active_devices[idx] = last;
+	last->active_device_idx = idx;
+	ctx->update_groups_dirty = true;
+	ohmd_atomic_store(&ctx->num_closes, ctx->num_closes + 1);
 
-	ctx->num_active_devices--;
+#if DRIVER_SHM
+	if(ctx->shm_server)
+		oshm_server_remove(ctx->shm_server, device);
+#endif
 
-	for(int i = idx; i < ctx->num_active_devices; i++)
-		ctx->active_devices[i]->active_device_idx--;
+	destroy_device(device);
 
 	ohmd_unlock_mutex(ctx->update_mutex);
 
@@ -378,6 +840,18 @@ static int ohmd_device_getf_unp(ohmd_device* device, ohmd_float_value type, floa
 		}
 		return OHMD_S_OK;
 	}
+	case OHMD_POSE_FILTER_POSITION:
+		memcpy(out, &device->pose_filter.pos_params, sizeof(float) * 3);
+		return OHMD_S_OK;
+	case OHMD_POSE_FILTER_ROTATION:
+		memcpy(out, &device->pose_filter.rot_params, sizeof(float) * 3);
+		return OHMD_S_OK;
+	case OHMD_LEFT_EYE_FRUSTUM_TANGENTS:
+		odistortion_get_tangents(device, OHMD_EYE_LEFT, out);
+		return OHMD_S_OK;
+	case OHMD_RIGHT_EYE_FRUSTUM_TANGENTS:
+		odistortion_get_tangents(device, OHMD_EYE_RIGHT, out);
+		return OHMD_S_OK;
 	default:
 		return device->getf(device, type, out);
 	}
@@ -439,6 +913,21 @@ static int ohmd_device_setf_unp(ohmd_device* device, ohmd_float_value type, cons
 
 			return device->setf(device, type, in);
 		}
+	case OHMD_POSE_FILTER_POSITION:
+	case OHMD_POSE_FILTER_ROTATION:
+		{
+			if(in[0] > 0 && (in[1] < 0 || in[2] <= 0))
+				return OHMD_S_INVALID_PARAMETER;
+
+			one_euro_params* p = type == OHMD_POSE_FILTER_POSITION ?
+				&device->pose_filter.pos_params : &device->pose_filter.rot_params;
+
+			p->min_cutoff = in[0];
+			p->beta = in[1];
+			p->d_cutoff = in[2];
+
+			return OHMD_S_OK;
+		}
 	default:
 		return OHMD_S_INVALID_PARAMETER;
 	}
@@ -501,6 +990,29 @@ static int ohmd_device_set_data_unp(ohmd_device* device, ohmd_data_value type, c
 			device->set_data(device, OHMD_DRIVER_PROPERTIES, in);
 			return OHMD_S_OK;
 
+    case OHMD_EXTERNAL_SENSOR_SAMPLES: {
+			const ohmd_sensor_samples* batch = (const ohmd_sensor_samples*)in;
+			if(!batch || batch->count < 0 || (batch->count > 0 && !batch->samples)){
+				ohmd_set_error(device->ctx, "invalid sensor sample batch");
+				return OHMD_S_INVALID_PARAMETER;
+			}
+
+			if(!device->set_data){
+				ohmd_set_error(device->ctx, "device doesn't take sensor samples");
+				return OHMD_S_UNSUPPORTED;
+			}
+
+			return device->set_data(device, OHMD_EXTERNAL_SENSOR_SAMPLES, in) == 0 ? OHMD_S_OK : OHMD_S_UNSUPPORTED;
+		}
+
+    case OHMD_EXTERNAL_SENSOR_RING:
+			if(!device->set_data){
+				ohmd_set_error(device->ctx, "device doesn't take a sample ring");
+				return OHMD_S_UNSUPPORTED;
+			}
+
+			return device->set_data(device, OHMD_EXTERNAL_SENSOR_RING, in) == 0 ? OHMD_S_OK : OHMD_S_UNSUPPORTED;
+
     default:
       return OHMD_S_INVALID_PARAMETER;
     }
@@ -515,6 +1027,310 @@ OHMD_APIENTRYDLL int OHMD_APIENTRY ohmd_device_set_data(ohmd_device* device, ohm
 	return ret;
 }
 
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_imu_preintegration(ohmd_device* device, double t0, double t1, ohmd_imu_preintegration* out)
+{
+	ohmd_status ret;
+
+	ohmd_lock_mutex(device->ctx->update_mutex);
+
+	if(device->fusion && device->fusion->preint){
+		ret = opreint_get(device->fusion->preint, t0, t1, out);
+		if(ret != OHMD_S_OK)
+			ohmd_set_error(device->ctx, "no pre-integrated samples between %f and %f", t0, t1);
+	} else {
+		ohmd_set_error(device->ctx, "IMU pre-integration not enabled for this device");
+		ret = OHMD_S_UNSUPPORTED;
+	}
+
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return ret;
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_distortion_mesh(ohmd_device* device, ohmd_eye eye, int grid_width, int grid_height, ohmd_distortion_mesh* out)
+{
+	if(eye != OHMD_EYE_LEFT && eye != OHMD_EYE_RIGHT){
+		ohmd_set_error(device->ctx, "invalid eye: %d", eye);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	// take the parameters and the cached mesh under the lock, and build without holding it
+	distortion_params params;
+	distortion_mesh mesh;
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	odistortion_get_params(device, eye, &params);
+	mesh = device->distortion_mesh[eye];
+	memset(&device->distortion_mesh[eye], 0, sizeof(distortion_mesh));
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	ohmd_status ret = odistortion_mesh_update(device->ctx, &mesh, &params, grid_width, grid_height);
+
+	if(ret == OHMD_S_OK){
+		out->num_vertices = (grid_width + 1) * (grid_height + 1);
+		out->num_indices = 6 * grid_width * grid_height;
+		out->vertices = mesh.vertices;
+		out->indices = mesh.indices;
+	}
+
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	odistortion_mesh_free(&device->distortion_mesh[eye]);
+	device->distortion_mesh[eye] = mesh;
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return ret;
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_composite(ohmd_device* device, const ohmd_rgba_image* left, const ohmd_rgba_image* right, ohmd_rgba_image* panel)
+{
+	// both eyes are taken under one lock so they match, the compositing runs without it
+	distortion_params params[2];
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	odistortion_get_params(device, OHMD_EYE_LEFT, &params[OHMD_EYE_LEFT]);
+	odistortion_get_params(device, OHMD_EYE_RIGHT, &params[OHMD_EYE_RIGHT]);
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return odistortion_composite(device->ctx, params, left, right, panel);
+}
+
+static ohmd_status map_points(ohmd_device* device, ohmd_eye eye, ohmd_color_channel channel, int count, const float* in, float* out,
+	void (*map)(const distortion_params*, int, int, const float*, float*))
+{
+	if(eye != OHMD_EYE_LEFT && eye != OHMD_EYE_RIGHT){
+		ohmd_set_error(device->ctx, "invalid eye: %d", eye);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	if(channel < OHMD_CHANNEL_RED || channel > OHMD_CHANNEL_BLUE){
+		ohmd_set_error(device->ctx, "invalid color channel: %d", channel);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	if(count < 0){
+		ohmd_set_error(device->ctx, "invalid point count: %d", count);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	// only the parameters are read under the lock, the points are mapped on a copy
+	distortion_params p;
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	odistortion_get_params(device, eye, &p);
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	map(&p, channel, count, in, out);
+
+	return OHMD_S_OK;
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_distort_points(ohmd_device* device, ohmd_eye eye, ohmd_color_channel channel, int count, const float* in, float* out)
+{
+	return map_points(device, eye, channel, count, in, out, odistortion_distort_points);
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_undistort_points(ohmd_device* device, ohmd_eye eye, ohmd_color_channel channel, int count, const float* in, float* out)
+{
+	return map_points(device, eye, channel, count, in, out, odistortion_undistort_points);
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_render_target_size(ohmd_device* device, float pixels_per_display_pixel, int* width, int* height)
+{
+	if(!(pixels_per_display_pixel > 0)){
+		ohmd_set_error(device->ctx, "invalid pixel density: %f", pixels_per_display_pixel);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	odistortion_get_render_target_size(device, pixels_per_display_pixel, width, height);
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return OHMD_S_OK;
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_control_events(ohmd_device* device, ohmd_control_event* events, int max, int* count)
+{
+	*count = 0;
+
+	if(max < 0){
+		ohmd_set_error(device->ctx, "invalid event count: %d", max);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	if(!device->control_events.entries)
+		return OHMD_S_UNSUPPORTED;
+
+	while(*count < max && ospsc_queue_pop(&device->control_events, events + *count))
+		(*count)++;
+
+	return OHMD_S_OK;
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_frame_event(ohmd_device* device, ohmd_frame_event event, double time)
+{
+	ohmd_status ret = OHMD_S_OK;
+
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	switch(event){
+	case OHMD_FRAME_BEGIN:
+		oframe_timing_begin(&device->frame_timing, time);
+		break;
+	case OHMD_FRAME_SUBMIT:
+		oframe_timing_submit(&device->frame_timing, time);
+		break;
+	case OHMD_FRAME_PRESENT:
+		oframe_timing_present(&device->frame_timing, time);
+		break;
+	default:
+		ohmd_set_error(device->ctx, "invalid frame event: %d", event);
+		ret = OHMD_S_INVALID_PARAMETER;
+	}
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return ret;
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_frame_timing(ohmd_device* device, ohmd_frame_timing* out)
+{
+	double now = ohmd_get_tick();
+
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	const frame_timing* ft = &device->frame_timing;
+	out->display_period = oframe_timing_get_period(ft);
+	out->render_time = oframe_timing_get_render_time(ft);
+	out->submit_to_display = oframe_timing_get_latency(ft);
+	out->predicted_display_time = oframe_timing_predict(ft, now);
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return OHMD_S_OK;
+}
+
+// extrapolates the rotation with the latest angular velocity of the fusion, if the driver has one
+static void predict_rotation(const ohmd_device* device, double display_time, quatf* rot)
+{
+	const fusion* f = device->fusion;
+	if(!f)
+		return;
+
+	float dt = (float)OHMD_MIN(OHMD_MAX(display_time - f->sample_time, 0.0), MAX_TIMEWARP_PREDICTION);
+
+	// the angular velocity is in the sensor frame of the fusion orientation, apply it in world space
+	vec3f ang_vel;
+	oquatf_get_rotated(&f->orient, &f->ang_vel, &ang_vel);
+
+	float angle = ovec3f_get_length(&ang_vel) * dt;
+	if(angle < 1e-6f)
+		return;
+
+	quatf step, out;
+	oquatf_init_axis(&step, &ang_vel, angle);
+	oquatf_mult(&step, rot, &out);
+	oquatf_normalize_me(&out);
+	*rot = out;
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_timewarp_matrix(ohmd_device* device, ohmd_eye eye, const float* render_rotation, double display_time, float* out)
+{
+	if(eye != OHMD_EYE_LEFT && eye != OHMD_EYE_RIGHT){
+		ohmd_set_error(device->ctx, "invalid eye: %d", eye);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	ohmd_lock_mutex(device->ctx->update_mutex);
+
+	// straight from the driver, the pose filter adds latency which is what this is meant to remove
+	quatf rot;
+	int ret = device->getf(device, OHMD_ROTATION_QUAT, (float*)&rot);
+	if(ret != OHMD_S_OK){
+		ohmd_unlock_mutex(device->ctx->update_mutex);
+		return ret;
+	}
+
+	predict_rotation(device, display_time, &rot);
+	oquatf_mult_me(&rot, &device->rotation_correction);
+
+	float tangents[4];
+	odistortion_get_tangents(device, eye, tangents);
+	odistortion_timewarp_matrix(tangents, (const quatf*)render_rotation, &rot, out);
+
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return OHMD_S_OK;
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_shading_rate_map(ohmd_device* device, ohmd_eye eye, int width, int height, float quality, unsigned char* out)
+{
+	if(eye != OHMD_EYE_LEFT && eye != OHMD_EYE_RIGHT){
+		ohmd_set_error(device->ctx, "invalid eye: %d", eye);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	// the map is built without holding the lock
+	distortion_params params;
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	odistortion_get_params(device, eye, &params);
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return odistortion_shading_rate_map(device->ctx, &params, width, height, quality, out);
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_get_area_mesh(ohmd_device* device, ohmd_eye eye, ohmd_area_mesh_type type, int segments, ohmd_area_mesh* out)
+{
+	if(eye != OHMD_EYE_LEFT && eye != OHMD_EYE_RIGHT){
+		ohmd_set_error(device->ctx, "invalid eye: %d", eye);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	if(type != OHMD_HIDDEN_AREA_MESH && type != OHMD_VISIBLE_AREA_MESH){
+		ohmd_set_error(device->ctx, "invalid area mesh type: %d", type);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	// like ohmd_device_get_distortion_mesh, the area is built without holding the lock
+	distortion_params params;
+	distortion_area area;
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	odistortion_get_params(device, eye, &params);
+	area = device->distortion_area[type][eye];
+	memset(&device->distortion_area[type][eye], 0, sizeof(distortion_area));
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	ohmd_status ret = odistortion_area_update(device->ctx, &area, &params, type, segments);
+
+	if(ret == OHMD_S_OK){
+		out->num_vertices = area.num_vertices;
+		out->num_indices = area.num_indices;
+		out->vertices = area.vertices;
+		out->indices = area.indices;
+	}
+
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	odistortion_area_free(&device->distortion_area[type][eye]);
+	device->distortion_area[type][eye] = area;
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return ret;
+}
+
+OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_bake_distortion_map(ohmd_device* device, ohmd_eye eye, int width, int height,
+	ohmd_distortion_map_format format, void* out, ohmd_distortion_map_info* info)
+{
+	if(eye != OHMD_EYE_LEFT && eye != OHMD_EYE_RIGHT){
+		ohmd_set_error(device->ctx, "invalid eye: %d", eye);
+		return OHMD_S_INVALID_PARAMETER;
+	}
+
+	// the map is baked without holding the lock
+	distortion_params params;
+	ohmd_lock_mutex(device->ctx->update_mutex);
+	odistortion_get_params(device, eye, &params);
+	ohmd_unlock_mutex(device->ctx->update_mutex);
+
+	return odistortion_bake_map(device->ctx, &params, width, height, format, out, info);
+}
+
+OHMD_APIENTRYDLL double OHMD_APIENTRY ohmd_get_time(void)
+{
+	return ohmd_get_tick();
+}
+
 OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_settings_seti(ohmd_device_settings* settings, ohmd_int_settings key, const int* val)
 {
 	switch(key){
@@ -522,6 +1338,17 @@ OHMD_APIENTRYDLL ohmd_status OHMD_APIENTRY ohmd_device_settings_seti(ohmd_device
 		settings->automatic_update = val[0] == 0 ? false : true;
 		return OHMD_S_OK;
 
+	case OHMD_IDS_FUSION_ENGINE:
+		if(val[0] != OHMD_FUSION_ENGINE_COMPLEMENTARY && val[0] != OHMD_FUSION_ENGINE_ESKF)
+			return OHMD_S_INVALID_PARAMETER;
+
+		settings->fusion_engine = (ohmd_fusion_engine)val[0];
+		return OHMD_S_OK;
+
+	case OHMD_IDS_IMU_PREINTEGRATION:
+		settings->imu_preintegration = val[0] == 0 ? false : true;
+		return OHMD_S_OK;
+
 	default:
 		return OHMD_S_INVALID_PARAMETER;
 	}
@@ -545,6 +1372,39 @@ void* ohmd_allocfn(ohmd_context* ctx, const char* e_msg, size_t size)
 	return ret;
 }
 
+bool ohmd_grow(ohmd_context* ctx, void** data, int* capacity, int count, size_t size)
+{
+	if(count <= *capacity)
+		return true;
+
+	int new_capacity = *capacity ? *capacity : 16;
+	while(new_capacity < count)
+		new_capacity *= 2;
+
+	void* grown = realloc(*data, (size_t)new_capacity * size);
+	if(!grown){
+		ohmd_set_error(ctx, "could not grow an array to %d entries", new_capacity);
+		return false;
+	}
+
+	*data = grown;
+	*capacity = new_capacity;
+	return true;
+}
+
+ohmd_device_desc* ohmd_device_list_add(ohmd_device_list* list)
+{
+	ohmd_device_desc* desc = &list->overflow;
+
+	if(ohmd_grow(list->ctx, (void**)&list->devices, &list->capacity, list->num_devices + 1, sizeof(ohmd_device_desc)))
+		desc = &list->devices[list->num_devices++];
+	else
+		LOGE("out of memory, not listing all devices");
+
+	memset(desc, 0, sizeof(ohmd_device_desc));
+	return desc;
+}
+
 void ohmd_set_default_device_properties(ohmd_device_properties* props)
 {
 	props->ipd = 0.061f;
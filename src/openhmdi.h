@@ -18,11 +18,19 @@
 
 #include "openhmd.h"
 #include "omath.h"
+#include "fusion.h"
+#include "clock_sync.h"
+#include "pose_filter.h"
+#include "position_filter.h"
+#include "distortion.h"
+#include "frame_timing.h"
+#include "worker_pool.h"
+#include "mem_pool.h"
+#include "spsc_queue.h"
+#include "plugin.h"
 #include "platform.h"
 #include "utils.h"
 
-#define OHMD_MAX_DEVICES 16
-
 #define OHMD_MAX(_a, _b) ((_a) > (_b) ? (_a) : (_b))
 #define OHMD_MIN(_a, _b) ((_a) < (_b) ? (_a) : (_b))
 
@@ -32,6 +40,8 @@
 #define OHMD_VERSION_MINOR 3
 #define OHMD_VERSION_PATCH 0
 
+#define OHMD_MAX_CONTROLS 64
+
 typedef struct ohmd_driver ohmd_driver;
 
 typedef struct {
@@ -48,7 +58,10 @@ typedef struct {
 
 typedef struct {
 	int num_devices;
-	ohmd_device_desc devices[OHMD_MAX_DEVICES];
+	int capacity;
+	ohmd_device_desc* devices; // drivers append with ohmd_device_list_add
+	ohmd_device_desc overflow; // handed out when growing fails, never listed
+	ohmd_context* ctx;
 } ohmd_device_list;
 
 struct ohmd_driver {
@@ -56,14 +69,16 @@ struct ohmd_driver {
 	ohmd_device* (*open_device)(ohmd_driver* driver, ohmd_device_desc* desc);
 	void (*destroy)(ohmd_driver* driver);
 	ohmd_context* ctx;
+	ohmd_mutex* open_mutex; // set by the core, opens of one driver never run concurrently
+	ohmd_mutex* group_mutex; // set by the core, held while updating a group of manually updated devices and while closing a device
 };
 
 typedef struct {
 		int hres;
 		int vres;
 		int control_count;
-		int controls_hints[64];
-		int controls_types[64];
+		int controls_hints[OHMD_MAX_CONTROLS];
+		int controls_types[OHMD_MAX_CONTROLS];
 
 		float hsize;
 		float vsize;
@@ -89,14 +104,12 @@ typedef struct {
 struct ohmd_device_settings
 {
 	bool automatic_update;
+	ohmd_fusion_engine fusion_engine;
+	bool imu_preintegration;
 };
 
 struct ohmd_device {
-	ohmd_device_properties properties;
-
-	quatf rotation_correction;
-	vec3f position_correction;
-
+	// what the update loops touch comes first, the large per device data after it
 	int (*getf)(ohmd_device* device, ohmd_float_value type, float* out);
 	int (*setf)(ohmd_device* device, ohmd_float_value type, const float* in);
 	int (*seti)(ohmd_device* device, ohmd_int_value type, const int* in);
@@ -109,33 +122,72 @@ struct ohmd_device {
 
 	ohmd_device_settings settings;
 
-	int active_device_idx; // index into ohmd_device->active_devices[]
+	int active_device_idx; // index into ohmd_context->active_devices
 
 	quatf rotation;
 	vec3f position;
+
+	pose_filter pose_filter;
+
+	fusion* fusion; // set by drivers using ofusion, lets the core select the fusion engine
+
+	quatf rotation_correction;
+	vec3f position_correction;
+
+	ohmd_device_properties properties;
+	ohmd_device_desc desc; // as listed when the device was opened
+
+	distortion_mesh distortion_mesh[2]; // per eye, see ohmd_device_get_distortion_mesh
+	distortion_area distortion_area[2][2]; // per area mesh type and eye, see ohmd_device_get_area_mesh
+
+	frame_timing frame_timing; // see ohmd_device_frame_event
+
+	spsc_queue control_events; // of ohmd_control_event, for devices with controls
+	float control_values[OHMD_MAX_CONTROLS]; // as last queued, see ohmd_device_report_controls
+	bool reports_controls; // set by drivers queueing the control events of this device from the update of another one
 };
 
 
 struct ohmd_context {
-	ohmd_driver* drivers[16];
-	int num_drivers;
+	ohmd_driver** drivers;
+	int num_drivers, drivers_capacity;
+
+	void** plugins; // driver module handles, closed after the drivers are destroyed
+	int num_plugins, plugins_capacity;
 
 	ohmd_device_list list;
 
-	ohmd_device* active_devices[256];
-	int num_active_devices;
+	// handles stay valid until closed, closing swaps the last device into the gap
+	ohmd_device** active_devices;
+	int num_active_devices, active_devices_capacity;
+
+	// manually updated devices by connection, rebuilt by ohmd_ctx_update after devices are opened or closed
+	ohmd_device** update_order;
+	int* update_groups; // start of each group in update_order, and the end of the last
+	ohmd_driver** update_group_drivers; // of each group, taken at build time as the devices may close
+	int num_update_groups, update_order_capacity, update_groups_capacity, update_group_drivers_capacity;
+	bool update_groups_dirty;
+	volatile uint32_t num_closes; // devices closed so far, groups built before a close are stale
+	uint32_t update_groups_closes; // num_closes when the groups were built
+
+	worker_pool* update_pool; // see ohmd_ctx_set_update_threads
 
 	ohmd_thread* update_thread;
 	ohmd_mutex* update_mutex;
 
 	bool update_request_quit;
 
+	struct shm_server* shm_server; // see ohmd_ctx_publish
+
 	uint64_t monotonic_ticks_per_sec;
 
 	char error_msg[OHMD_STR_SIZE];
 };
 
 // helper functions
+bool ohmd_grow(ohmd_context* ctx, void** data, int* capacity, int count, size_t size);
+void ohmd_add_driver(ohmd_context* ctx, ohmd_driver* driver);
+ohmd_device_desc* ohmd_device_list_add(ohmd_device_list* list);
 void ohmd_monotonic_init(ohmd_context* ctx);
 uint64_t ohmd_monotonic_get(ohmd_context* ctx);
 uint64_t ohmd_monotonic_per_sec(ohmd_context* ctx);
@@ -145,6 +197,10 @@ void ohmd_calc_default_proj_matrices(ohmd_device_properties* props);
 void ohmd_set_universal_distortion_k(ohmd_device_properties* props, float a, float b, float c, float d);
 void ohmd_set_universal_aberration_k(ohmd_device_properties* props, float r, float g, float b);
 
+// queues the controls that changed since the last call, drivers call it from their decode paths,
+// the update that decodes must be the only one calling it for a device, see reports_controls
+void ohmd_device_report_controls(ohmd_device* device, double device_time, double host_time);
+
 // drivers
 ohmd_driver* ohmd_create_dummy_drv(ohmd_context* ctx);
 ohmd_driver* ohmd_create_oculus_rift_drv(ohmd_context* ctx);
@@ -158,9 +214,9 @@ ohmd_driver* ohmd_create_xgvr_drv(ohmd_context* ctx);
 ohmd_driver* ohmd_create_vrtek_drv(ohmd_context* ctx);
 ohmd_driver* ohmd_create_external_drv(ohmd_context* ctx);
 ohmd_driver* ohmd_create_android_drv(ohmd_context* ctx);
+ohmd_driver* ohmd_create_shm_drv(ohmd_context* ctx);
 
 #include "log.h"
 #include "omath.h"
-#include "fusion.h"
 
 #endif
@@ -173,6 +173,36 @@ void ohmd_unlock_mutex(ohmd_mutex* mutex)
 		pthread_mutex_unlock((pthread_mutex_t*)mutex);
 }
 
+ohmd_cond* ohmd_create_cond(ohmd_context* ctx)
+{
+	pthread_cond_t* cond = ohmd_alloc(ctx, sizeof(pthread_cond_t));
+	if(cond == NULL)
+		return NULL;
+
+	if(pthread_cond_init(cond, NULL) != 0){
+		free(cond);
+		cond = NULL;
+	}
+
+	return (ohmd_cond*)cond;
+}
+
+void ohmd_destroy_cond(ohmd_cond* cond)
+{
+	pthread_cond_destroy((pthread_cond_t*)cond);
+	free(cond);
+}
+
+void ohmd_cond_wait(ohmd_cond* cond, ohmd_mutex* mutex)
+{
+	pthread_cond_wait((pthread_cond_t*)cond, (pthread_mutex_t*)mutex);
+}
+
+void ohmd_cond_broadcast(ohmd_cond* cond)
+{
+	pthread_cond_broadcast((pthread_cond_t*)cond);
+}
+
 /// Handling ovr service
 void ohmd_toggle_ovr_service(int state) //State is 0 for Disable, 1 for Enable
 {
@@ -121,6 +121,44 @@ void ohmd_unlock_mutex(ohmd_mutex* mutex)
 		ReleaseMutex(mutex->handle);
 }
 
+// kernel mutexes don't work with condition variables, a semaphore holds the wakeups instead
+struct ohmd_cond {
+	HANDLE sema;
+	LONG waiters; // protected by the mutex waited with
+};
+
+ohmd_cond* ohmd_create_cond(ohmd_context* ctx)
+{
+	ohmd_cond* cond = ohmd_alloc(ctx, sizeof(ohmd_cond));
+	if(!cond)
+		return NULL;
+
+	cond->sema = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+
+	return cond;
+}
+
+void ohmd_destroy_cond(ohmd_cond* cond)
+{
+	CloseHandle(cond->sema);
+	free(cond);
+}
+
+void ohmd_cond_wait(ohmd_cond* cond, ohmd_mutex* mutex)
+{
+	cond->waiters++;
+	SignalObjectAndWait(mutex->handle, cond->sema, INFINITE, FALSE);
+	WaitForSingleObject(mutex->handle, INFINITE);
+}
+
+void ohmd_cond_broadcast(ohmd_cond* cond)
+{
+	if(cond->waiters > 0){
+		ReleaseSemaphore(cond->sema, cond->waiters, NULL);
+		cond->waiters = 0;
+	}
+}
+
 int findEndPoint(char* path, int endpoint)
 {
 	char comp[8];
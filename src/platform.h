@@ -11,6 +11,7 @@
 #ifndef PLATFORM_H
 #define PLATFORM_H
 
+#include <stdint.h>
 #include "openhmd.h"
 
 double ohmd_get_tick();
@@ -18,6 +19,7 @@ void ohmd_toggle_ovr_service(int state);
 
 typedef struct ohmd_thread ohmd_thread;
 typedef struct ohmd_mutex ohmd_mutex;
+typedef struct ohmd_cond ohmd_cond;
 
 ohmd_mutex* ohmd_create_mutex(ohmd_context* ctx);
 void ohmd_destroy_mutex(ohmd_mutex* mutex);
@@ -28,6 +30,23 @@ void ohmd_unlock_mutex(ohmd_mutex* mutex);
 ohmd_thread* ohmd_create_thread(ohmd_context* ctx, unsigned int (*routine)(void* arg), void* arg);
 void ohmd_destroy_thread(ohmd_thread* thread);
 
+// waits may wake spuriously, broadcast with the mutex held
+ohmd_cond* ohmd_create_cond(ohmd_context* ctx);
+void ohmd_destroy_cond(ohmd_cond* cond);
+
+void ohmd_cond_wait(ohmd_cond* cond, ohmd_mutex* mutex);
+void ohmd_cond_broadcast(ohmd_cond* cond);
+
+// acquire loads and release stores for indices and flags shared between threads
+#if defined(_MSC_VER)
+// volatile accesses are acquire and release under /volatile:ms, the default on x86
+static inline uint32_t ohmd_atomic_load(const volatile uint32_t* p) { return *p; }
+static inline void ohmd_atomic_store(volatile uint32_t* p, uint32_t value) { *p = value; }
+#else
+static inline uint32_t ohmd_atomic_load(const volatile uint32_t* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static inline void ohmd_atomic_store(volatile uint32_t* p, uint32_t value) { __atomic_store_n(p, value, __ATOMIC_RELEASE); }
+#endif
+
 /* String functions */
 
 int findEndPoint(char* path, int endpoint);
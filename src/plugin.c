@@ -0,0 +1,136 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Driver Selection and Plugin Loading Implementation */
+
+/*
+ * Drivers built as modules are named openhmd-drv-<name>.so and live in the
+ * directory given by OHMD_PLUGIN_PATH, or the install directory. Modules of
+ * drivers OHMD_DRIVERS doesn't list are never opened, so they cost neither
+ * memory nor probing time.
+ */
+
+#if DRIVER_PLUGINS
+#define _POSIX_C_SOURCE 200809L
+#include <dirent.h>
+#include <dlfcn.h>
+#endif
+
+#include <string.h>
+#include "openhmdi.h"
+
+#ifndef OHMD_PLUGIN_DIR
+#define OHMD_PLUGIN_DIR "/usr/local/lib/openhmd"
+#endif
+
+bool oplugin_driver_allowed(const char* name)
+{
+	const char* list = getenv(OHMD_DRIVERS_ENV);
+	if(!list || !list[0])
+		return true;
+
+	size_t len = strlen(name);
+
+	// comma or space separated
+	for(const char* p = list; *p; ){
+		size_t n = strcspn(p, ", ");
+		if(n == len && strncmp(p, name, len) == 0)
+			return true;
+
+		p += n;
+		p += strspn(p, ", ");
+	}
+
+	return false;
+}
+
+#if DRIVER_PLUGINS
+
+static void load_plugin(ohmd_context* ctx, const char* dir, const char* file)
+{
+	char name[OHMD_STR_SIZE];
+	const char* start = file + strlen(OHMD_PLUGIN_PREFIX);
+	const char* ext = strrchr(file, '.');
+
+	if(!ext || strcmp(ext, ".so") != 0 || ext - start <= 0 || ext - start >= OHMD_STR_SIZE)
+		return;
+
+	memcpy(name, start, ext - start);
+	name[ext - start] = 0;
+
+	if(!oplugin_driver_allowed(name))
+		return;
+
+	char path[1024];
+	snprintf(path, sizeof(path), "%s/%s", dir, file);
+
+	void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+	if(!handle){
+		LOGW("could not load driver module %s: %s", path, dlerror());
+		return;
+	}
+
+	const ohmd_plugin_info* info = (const ohmd_plugin_info*)dlsym(handle, "ohmd_plugin");
+	if(!info || info->abi != OHMD_PLUGIN_ABI || info->context_size != sizeof(ohmd_context) ||
+	   info->device_size != sizeof(ohmd_device) || info->driver_size != sizeof(ohmd_driver)){
+		LOGW("driver module %s was built for another version of OpenHMD", path);
+		dlclose(handle);
+		return;
+	}
+
+	if(!ohmd_grow(ctx, (void**)&ctx->plugins, &ctx->plugins_capacity, ctx->num_plugins + 1, sizeof(void*))){
+		dlclose(handle);
+		return;
+	}
+
+	ctx->plugins[ctx->num_plugins++] = handle;
+
+	LOGI("loaded driver module %s", info->name);
+	ohmd_add_driver(ctx, info->create(ctx));
+}
+
+void oplugin_load_all(ohmd_context* ctx)
+{
+	const char* dir = getenv(OHMD_PLUGIN_PATH_ENV);
+	if(!dir || !dir[0])
+		dir = OHMD_PLUGIN_DIR;
+
+	// sorted, so the drivers are added in the same order every time
+	struct dirent** entries = NULL;
+	int count = scandir(dir, &entries, NULL, alphasort);
+	if(count < 0)
+		return;
+
+	for(int i = 0; i < count; i++){
+		if(strncmp(entries[i]->d_name, OHMD_PLUGIN_PREFIX, strlen(OHMD_PLUGIN_PREFIX)) == 0)
+			load_plugin(ctx, dir, entries[i]->d_name);
+		free(entries[i]);
+	}
+
+	free(entries);
+}
+
+void oplugin_unload_all(ohmd_context* ctx)
+{
+	for(int i = 0; i < ctx->num_plugins; i++)
+		dlclose(ctx->plugins[i]);
+
+	free(ctx->plugins);
+	ctx->plugins = NULL;
+	ctx->num_plugins = 0;
+}
+
+#else
+
+void oplugin_load_all(ohmd_context* ctx)
+{
+}
+
+void oplugin_unload_all(ohmd_context* ctx)
+{
+}
+
+#endif
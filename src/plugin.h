@@ -0,0 +1,36 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Driver Selection and Plugin Loading */
+
+
+#ifndef PLUGIN_H
+#define PLUGIN_H
+
+#include <stdbool.h>
+#include "openhmd.h"
+
+#define OHMD_PLUGIN_ABI 1
+#define OHMD_PLUGIN_PREFIX "openhmd-drv-"
+#define OHMD_PLUGIN_PATH_ENV "OHMD_PLUGIN_PATH"
+#define OHMD_DRIVERS_ENV "OHMD_DRIVERS"
+
+// exported as ohmd_plugin by every driver module, the sizes catch modules built against other internals
+typedef struct {
+	int abi;
+	unsigned context_size, device_size, driver_size;
+	const char* name;
+	struct ohmd_driver* (*create)(ohmd_context* ctx);
+} ohmd_plugin_info;
+
+// true if OHMD_DRIVERS is unset or lists name
+bool oplugin_driver_allowed(const char* name);
+
+// loads the allowed driver modules and adds their drivers to the context
+void oplugin_load_all(ohmd_context* ctx);
+void oplugin_unload_all(ohmd_context* ctx);
+
+#endif
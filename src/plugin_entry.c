@@ -0,0 +1,23 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Driver Module Entry Point */
+
+/*
+ * Built into every driver module, OHMD_PLUGIN_NAME and OHMD_PLUGIN_CREATE
+ * are set by the build to the driver's name and creation function.
+ */
+
+#include "openhmdi.h"
+
+ohmd_driver* OHMD_PLUGIN_CREATE(ohmd_context* ctx);
+
+OHMD_APIENTRYDLL const ohmd_plugin_info ohmd_plugin = {
+	OHMD_PLUGIN_ABI,
+	sizeof(ohmd_context), sizeof(ohmd_device), sizeof(ohmd_driver),
+	OHMD_PLUGIN_NAME,
+	OHMD_PLUGIN_CREATE,
+};
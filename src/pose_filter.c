@@ -0,0 +1,132 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Pose Output Filter Implementation */
+
+/*
+ * One Euro filter (Casiez et al. 2012): a first order low pass whose cutoff
+ * rises with the filtered speed of the signal, so it smooths heavily while
+ * still and hardly adds lag while moving. Position is filtered as a vector,
+ * rotation is interpolated towards the new sample with the filtered angular
+ * velocity driving the cutoff.
+ */
+
+#include <string.h>
+#include "pose_filter.h"
+
+static float smoothing_factor(float dt, float cutoff)
+{
+	float tau = 1.0f / (2.0f * (float)M_PI * cutoff);
+	return 1.0f / (1.0f + tau / dt);
+}
+
+// low pass the derivative, then pick the smoothing for the value from its speed
+static float adaptive_alpha(const one_euro_params* p, float dt, vec3f* deriv, const vec3f* raw_deriv)
+{
+	float a = smoothing_factor(dt, p->d_cutoff);
+
+	for(int i = 0; i < 3; i++)
+		deriv->arr[i] += a * (raw_deriv->arr[i] - deriv->arr[i]);
+
+	return smoothing_factor(dt, p->min_cutoff + p->beta * ovec3f_get_length(deriv));
+}
+
+void opose_filter_init(pose_filter* me)
+{
+	memset(me, 0, sizeof(pose_filter));
+
+	// disabled by default, these are sensible starting points once enabled
+	me->pos_params.beta = 1.0f;
+	me->pos_params.d_cutoff = 1.0f;
+	me->rot_params.beta = 0.5f;
+	me->rot_params.d_cutoff = 1.0f;
+}
+
+void opose_filter_position(pose_filter* me, double time, vec3f* pos)
+{
+	if(me->pos_params.min_cutoff <= 0){
+		me->pos_valid = false;
+		return;
+	}
+
+	float dt = (float)(time - me->pos_time);
+
+	if(!me->pos_valid || dt <= 0 || dt > 1.0f){
+		// (re)start from the raw value, or nothing to do for a repeated timestamp
+		if(!me->pos_valid || dt > 1.0f){
+			me->pos = *pos;
+			me->pos_deriv = (vec3f){{0, 0, 0}};
+			me->pos_time = time;
+			me->pos_valid = true;
+		}
+		*pos = me->pos;
+		return;
+	}
+
+	vec3f delta, raw_deriv;
+	ovec3f_subtract(pos, &me->pos, &delta);
+
+	for(int i = 0; i < 3; i++)
+		raw_deriv.arr[i] = delta.arr[i] / dt;
+
+	float alpha = adaptive_alpha(&me->pos_params, dt, &me->pos_deriv, &raw_deriv);
+
+	for(int i = 0; i < 3; i++)
+		me->pos.arr[i] += alpha * delta.arr[i];
+
+	me->pos_time = time;
+	*pos = me->pos;
+}
+
+void opose_filter_rotation(pose_filter* me, double time, quatf* rot)
+{
+	if(me->rot_params.min_cutoff <= 0){
+		me->rot_valid = false;
+		return;
+	}
+
+	float dt = (float)(time - me->rot_time);
+
+	if(!me->rot_valid || dt <= 0 || dt > 1.0f){
+		if(!me->rot_valid || dt > 1.0f){
+			me->rot = *rot;
+			me->rot_deriv = (vec3f){{0, 0, 0}};
+			me->rot_time = time;
+			me->rot_valid = true;
+		}
+		*rot = me->rot;
+		return;
+	}
+
+	// take the short way around
+	quatf target = *rot;
+	if(oquatf_get_dot(&me->rot, &target) < 0){
+		for(int i = 0; i < 4; i++)
+			target.arr[i] = -target.arr[i];
+	}
+
+	// angular velocity as axis * angle / dt of the step from the filtered rotation
+	quatf diff;
+	vec3f raw_deriv = {{0, 0, 0}};
+	oquatf_diff(&me->rot, &target, &diff);
+
+	float sin_half = sqrtf(POW2(diff.x) + POW2(diff.y) + POW2(diff.z));
+	if(sin_half > 1e-9f){
+		float angle = 2.0f * atan2f(sin_half, diff.w);
+		for(int i = 0; i < 3; i++)
+			raw_deriv.arr[i] = diff.arr[i] / sin_half * angle / dt;
+	}
+
+	float alpha = adaptive_alpha(&me->rot_params, dt, &me->rot_deriv, &raw_deriv);
+
+	// normalized lerp, steps are small at tracking rates
+	for(int i = 0; i < 4; i++)
+		me->rot.arr[i] += alpha * (target.arr[i] - me->rot.arr[i]);
+	oquatf_normalize_me(&me->rot);
+
+	me->rot_time = time;
+	*rot = me->rot;
+}
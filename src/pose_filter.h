@@ -0,0 +1,40 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Pose Output Filter */
+
+
+#ifndef POSE_FILTER_H
+#define POSE_FILTER_H
+
+#include <stdbool.h>
+#include "omath.h"
+
+// One Euro filter parameters, a min_cutoff <= 0 disables the filter
+typedef struct {
+	float min_cutoff; // Hz, cutoff when not moving, lower means less jitter
+	float beta;       // cutoff increase per unit of speed, higher means less lag
+	float d_cutoff;   // Hz, cutoff of the speed estimate
+} one_euro_params;
+
+typedef struct {
+	one_euro_params pos_params, rot_params;
+
+	bool pos_valid, rot_valid;
+	double pos_time, rot_time;
+
+	vec3f pos;       // filtered position
+	vec3f pos_deriv; // filtered velocity, m/s
+
+	quatf rot;       // filtered rotation
+	vec3f rot_deriv; // filtered angular velocity, rad/s
+} pose_filter;
+
+void opose_filter_init(pose_filter* me);
+void opose_filter_position(pose_filter* me, double time, vec3f* pos);
+void opose_filter_rotation(pose_filter* me, double time, quatf* rot);
+
+#endif
@@ -0,0 +1,141 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Positional Kalman Filter Implementation */
+
+/*
+ * Each world axis is an independent three state filter over position, velocity
+ * and accelerometer bias. The world frame acceleration drives the prediction at
+ * IMU rate and the optical or base station position corrects it whenever one
+ * arrives, so the output stays smooth between measurements and its velocity
+ * can be used for prediction.
+ */
+
+#include <string.h>
+#include "openhmdi.h"
+
+static void reset(position_filter* me, const vec3f* pos, float variance)
+{
+	me->pos = *pos;
+	memset(&me->vel, 0, sizeof(vec3f));
+	memset(&me->accel_bias, 0, sizeof(vec3f));
+	memset(&me->accel, 0, sizeof(vec3f));
+	memset(me->P, 0, sizeof(me->P));
+
+	for(int i = 0; i < 3; i++){
+		me->P[i][0][0] = variance;
+		me->P[i][1][1] = 1.0f;
+		me->P[i][2][2] = 0.25f;
+	}
+
+	me->time_since_correction = 0;
+	me->valid = true;
+}
+
+void oposition_filter_init(position_filter* me)
+{
+	memset(me, 0, sizeof(position_filter));
+
+	me->accel_noise = 0.5f;
+	me->accel_bias_noise = 0.01f;
+	me->max_coast_time = 0.2f;
+	me->gravity = 9.82f;
+}
+
+void oposition_filter_predict(position_filter* me, float dt, const vec3f* world_accel)
+{
+	if(!me->valid || dt <= 0)
+		return;
+
+	float dt2 = dt * dt;
+	float qa = POW2(me->accel_noise) * dt;
+	float qb = POW2(me->accel_bias_noise) * dt;
+
+	me->time_since_correction += dt;
+
+	// without corrections the double integration diverges fast, bleed off the velocity
+	float damping = me->time_since_correction > me->max_coast_time ? expf(-dt / me->max_coast_time) : 1.0f;
+
+	for(int i = 0; i < 3; i++){
+		float a = world_accel->arr[i] - me->accel_bias.arr[i];
+		float* p = &me->pos.arr[i];
+		float* v = &me->vel.arr[i];
+
+		*p += *v * dt + 0.5f * a * dt2;
+		*v = (*v + a * dt) * damping;
+		me->accel.arr[i] = a;
+
+		// P = F P F^T + Q, F = [[1, dt, -dt^2/2], [0, 1, -dt], [0, 0, 1]]
+		float (*P)[3] = me->P[i];
+		float F[3][3] = {
+			{ 1, dt, -0.5f * dt2 },
+			{ 0, 1, -dt },
+			{ 0, 0, 1 },
+		};
+		float FP[3][3], out[3][3];
+
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				FP[r][c] = F[r][0] * P[0][c] + F[r][1] * P[1][c] + F[r][2] * P[2][c];
+
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				out[r][c] = FP[r][0] * F[c][0] + FP[r][1] * F[c][1] + FP[r][2] * F[c][2];
+
+		// acceleration noise enters through G = [dt^2/2, dt, 0]
+		out[0][0] += qa * 0.25f * dt2;
+		out[0][1] += qa * 0.5f * dt;
+		out[1][0] += qa * 0.5f * dt;
+		out[1][1] += qa;
+		out[2][2] += qb;
+
+		memcpy(P, out, sizeof(out));
+	}
+}
+
+void oposition_filter_predict_imu(position_filter* me, float dt, const quatf* orient, const vec3f* accel)
+{
+	vec3f world_accel;
+	oquatf_get_rotated(orient, accel, &world_accel);
+	world_accel.y -= me->gravity;
+
+	oposition_filter_predict(me, dt, &world_accel);
+}
+
+void oposition_filter_correct(position_filter* me, const vec3f* pos, float variance)
+{
+	if(!me->valid){
+		reset(me, pos, variance);
+		return;
+	}
+
+	for(int i = 0; i < 3; i++){
+		float (*P)[3] = me->P[i];
+
+		// H = [1, 0, 0]
+		float y = pos->arr[i] - me->pos.arr[i];
+		float S = P[0][0] + variance;
+		float K[3] = { P[0][0] / S, P[1][0] / S, P[2][0] / S };
+
+		me->pos.arr[i] += K[0] * y;
+		me->vel.arr[i] += K[1] * y;
+		me->accel_bias.arr[i] += K[2] * y;
+
+		// P = (I - K H) P
+		float row0[3] = { P[0][0], P[0][1], P[0][2] };
+		for(int r = 0; r < 3; r++)
+			for(int c = 0; c < 3; c++)
+				P[r][c] -= K[r] * row0[c];
+	}
+
+	me->time_since_correction = 0;
+}
+
+void oposition_filter_get_predicted(const position_filter* me, float ahead, vec3f* out)
+{
+	for(int i = 0; i < 3; i++)
+		out->arr[i] = me->pos.arr[i] + me->vel.arr[i] * ahead + 0.5f * me->accel.arr[i] * ahead * ahead;
+}
@@ -0,0 +1,38 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Positional Kalman Filter */
+
+
+#ifndef POSITION_FILTER_H
+#define POSITION_FILTER_H
+
+#include <stdbool.h>
+#include "omath.h"
+
+// per axis state: position, velocity, accelerometer bias (world frame)
+typedef struct {
+	bool valid;
+
+	vec3f pos, vel, accel_bias;
+	vec3f accel; // last bias corrected world acceleration, used for prediction
+	float P[3][3][3]; // covariance per axis
+
+	float time_since_correction;
+
+	float accel_noise;      // m/s^2, includes orientation error leaking gravity
+	float accel_bias_noise; // m/s^3/sqrt(Hz)
+	float max_coast_time;   // seconds without position before the velocity is damped
+	float gravity;          // m/s^2, removed from the world Y axis
+} position_filter;
+
+void oposition_filter_init(position_filter* me);
+void oposition_filter_predict(position_filter* me, float dt, const vec3f* world_accel);
+void oposition_filter_predict_imu(position_filter* me, float dt, const quatf* orient, const vec3f* accel);
+void oposition_filter_correct(position_filter* me, const vec3f* pos, float variance);
+void oposition_filter_get_predicted(const position_filter* me, float ahead, vec3f* out);
+
+#endif
@@ -0,0 +1,331 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* IMU Pre-integration Implementation */
+
+/*
+ * Every incoming sample appends the cumulative integration state since a
+ * common base entry to a ring buffer. The pre-integrated delta between any two
+ * buffered samples i and j is then a constant time expression of entries i and
+ * j alone, e.g. delta_v = R_i^T * (V_j - V_i).
+ *
+ * The bias jacobians use the usual first order approximation of the right
+ * jacobian (Jr ~ I) so they can be expressed as prefix sums as well.
+ *
+ * To keep the sums small enough for float precision the whole buffer is
+ * re-expressed relative to its oldest entry once every PREINT_MAX_SAMPLES
+ * samples, which is the same operation as a query.
+ */
+
+#include <string.h>
+#include "preint.h"
+
+typedef float mat3[3][3];
+
+static void m3_from_quat(const quatf* q, mat3 out)
+{
+	for(int j = 0; j < 3; j++){
+		vec3f e = {{0}}, col;
+		e.arr[j] = 1.0f;
+		oquatf_get_rotated(q, &e, &col);
+		for(int i = 0; i < 3; i++)
+			out[i][j] = col.arr[i];
+	}
+}
+
+static void m3_skew(const vec3f* v, mat3 out)
+{
+	out[0][0] =  0;     out[0][1] = -v->z; out[0][2] =  v->y;
+	out[1][0] =  v->z;  out[1][1] =  0;    out[1][2] = -v->x;
+	out[2][0] = -v->y;  out[2][1] =  v->x; out[2][2] =  0;
+}
+
+// out = a * b, out must not alias a or b
+static void m3_mult(const mat3 a, const mat3 b, mat3 out)
+{
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			out[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j];
+}
+
+// out = a^T * b, out must not alias a or b
+static void m3_mult_tn(const mat3 a, const mat3 b, mat3 out)
+{
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			out[i][j] = a[0][i] * b[0][j] + a[1][i] * b[1][j] + a[2][i] * b[2][j];
+}
+
+// out = a^T * v
+static void m3_mult_tv(const mat3 a, const vec3f* v, vec3f* out)
+{
+	for(int i = 0; i < 3; i++)
+		out->arr[i] = a[0][i] * v->x + a[1][i] * v->y + a[2][i] * v->z;
+}
+
+// me += s * a
+static void m3_add_scaled(mat3 me, const mat3 a, float s)
+{
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			me[i][j] += s * a[i][j];
+}
+
+static void m3_copy_out(const mat3 m, float s, float out[9])
+{
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			out[i * 3 + j] = s * m[i][j];
+}
+
+static void init_entry(preint_entry* e, double time)
+{
+	memset(e, 0, sizeof(preint_entry));
+	e->time = time;
+	e->rot.w = 1.0f;
+}
+
+/*
+ * Express entry k relative to entry r, this is both the pre-integration
+ * between r and k and the rebased entry when r becomes the new base.
+ */
+static void relative(const preint_entry* r, const preint_entry* k, preint_entry* out)
+{
+	preint_entry res;
+	mat3 Rr, tmp, tmp2, Wx;
+	vec3f v;
+	float T = k->tau - r->tau;
+
+	m3_from_quat(&r->rot, Rr);
+
+	res.time = k->time;
+	res.tau = T;
+
+	quatf r_inv = {{-r->rot.x, -r->rot.y, -r->rot.z, r->rot.w}};
+	oquatf_mult(&r_inv, &k->rot, &res.rot);
+
+	// vel = Rr^T * (Vk - Vr)
+	ovec3f_subtract(&k->vel, &r->vel, &v);
+	m3_mult_tv(Rr, &v, &res.vel);
+
+	// pos = Rr^T * (Pk - Pr - Vr * T)
+	for(int i = 0; i < 3; i++)
+		v.arr[i] = k->pos.arr[i] - r->pos.arr[i] - r->vel.arr[i] * T;
+	m3_mult_tv(Rr, &v, &res.pos);
+
+	// S = Rr^T * (Sk - Sr)
+	memcpy(tmp, k->S, sizeof(mat3));
+	m3_add_scaled(tmp, r->S, -1.0f);
+	m3_mult_tn(Rr, tmp, res.S);
+
+	// A = Rr^T * (Ak - Ar)
+	memcpy(tmp, k->A, sizeof(mat3));
+	m3_add_scaled(tmp, r->A, -1.0f);
+	m3_mult_tn(Rr, tmp, res.A);
+
+	// B = Rr^T * (Bk - Br - Ar * T)
+	memcpy(tmp, k->B, sizeof(mat3));
+	m3_add_scaled(tmp, r->B, -1.0f);
+	m3_add_scaled(tmp, r->A, -T);
+	m3_mult_tn(Rr, tmp, res.B);
+
+	// C = Rr^T * (Ck - Cr - [Vk - Vr]x * Sr)
+	ovec3f_subtract(&k->vel, &r->vel, &v);
+	m3_skew(&v, Wx);
+	m3_mult(Wx, r->S, tmp2);
+	memcpy(tmp, k->C, sizeof(mat3));
+	m3_add_scaled(tmp, r->C, -1.0f);
+	m3_add_scaled(tmp, tmp2, -1.0f);
+	m3_mult_tn(Rr, tmp, res.C);
+
+	// G = Rr^T * (Gk - Gr - Cr * T - [Pk - Pr]x * Sr + [Vr]x * Sr * T)
+	memcpy(tmp, k->G, sizeof(mat3));
+	m3_add_scaled(tmp, r->G, -1.0f);
+	m3_add_scaled(tmp, r->C, -T);
+
+	ovec3f_subtract(&k->pos, &r->pos, &v);
+	m3_skew(&v, Wx);
+	m3_mult(Wx, r->S, tmp2);
+	m3_add_scaled(tmp, tmp2, -1.0f);
+
+	m3_skew(&r->vel, Wx);
+	m3_mult(Wx, r->S, tmp2);
+	m3_add_scaled(tmp, tmp2, T);
+
+	m3_mult_tn(Rr, tmp, res.G);
+
+	*out = res;
+}
+
+static int ring_index(const imu_preint* me, int i)
+{
+	// i = 0 is the oldest entry
+	return (me->head - me->count + i + PREINT_MAX_SAMPLES) % PREINT_MAX_SAMPLES;
+}
+
+static void rebase(imu_preint* me)
+{
+	preint_entry base = me->entries[ring_index(me, 0)];
+
+	for(int i = 0; i < me->count; i++){
+		preint_entry* e = &me->entries[ring_index(me, i)];
+		relative(&base, e, e);
+	}
+
+	me->since_rebase = 0;
+}
+
+// index (0 = oldest) of the last entry at or before time, -1 if none
+static int find(const imu_preint* me, double time)
+{
+	int lo = 0, hi = me->count - 1;
+
+	if(me->count == 0 || me->entries[ring_index(me, 0)].time > time)
+		return -1;
+
+	while(lo < hi){
+		int mid = (lo + hi + 1) / 2;
+		if(me->entries[ring_index(me, mid)].time <= time)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+
+	return lo;
+}
+
+void opreint_init(imu_preint* me)
+{
+	memset(me, 0, sizeof(imu_preint));
+
+	me->gyro_noise = 2e-3f;
+	me->accel_noise = 5e-2f;
+}
+
+void opreint_add(imu_preint* me, double time, float dt, const vec3f* ang_vel, const vec3f* accel)
+{
+	preint_entry* e = &me->entries[me->head];
+
+	if(me->count == 0){
+		init_entry(e, time);
+	} else {
+		const preint_entry* prev = &me->entries[ring_index(me, me->count - 1)];
+		mat3 R, Wx, WS;
+		vec3f wa;
+
+		// sample timestamps must be strictly increasing for lookups
+		if(time <= prev->time)
+			time = prev->time + 1e-6;
+
+		m3_from_quat(&prev->rot, R);
+		oquatf_get_rotated(&prev->rot, accel, &wa);
+		m3_skew(&wa, Wx);
+		m3_mult(Wx, prev->S, WS);
+
+		*e = *prev;
+		e->time = time;
+		e->tau += dt;
+
+		for(int i = 0; i < 3; i++){
+			e->pos.arr[i] += prev->vel.arr[i] * dt + 0.5f * wa.arr[i] * dt * dt;
+			e->vel.arr[i] += wa.arr[i] * dt;
+		}
+
+		m3_add_scaled(e->B, prev->A, dt);
+		m3_add_scaled(e->B, R, 0.5f * dt * dt);
+		m3_add_scaled(e->A, R, dt);
+
+		m3_add_scaled(e->G, prev->C, dt);
+		m3_add_scaled(e->G, WS, 0.5f * dt * dt);
+		m3_add_scaled(e->C, WS, dt);
+
+		float ang_vel_length = ovec3f_get_length(ang_vel);
+		if(ang_vel_length > 0.0001f){
+			quatf delta;
+			oquatf_init_axis(&delta, ang_vel, ang_vel_length * dt);
+			oquatf_mult_me(&e->rot, &delta);
+			oquatf_normalize_me(&e->rot);
+		}
+
+		m3_from_quat(&e->rot, R);
+		m3_add_scaled(e->S, R, dt);
+	}
+
+	me->head = (me->head + 1) % PREINT_MAX_SAMPLES;
+	if(me->count < PREINT_MAX_SAMPLES)
+		me->count++;
+
+	if(++me->since_rebase >= PREINT_MAX_SAMPLES)
+		rebase(me);
+}
+
+ohmd_status opreint_get(const imu_preint* me, double t0, double t1, ohmd_imu_preintegration* out)
+{
+	if(me->count < 2)
+		return OHMD_S_INVALID_OPERATION;
+
+	if(t1 < t0)
+		return OHMD_S_INVALID_PARAMETER;
+
+	int i = find(me, t0);
+	int j = find(me, t1);
+
+	// the start must still be buffered, the end is clamped to the newest sample
+	if(i < 0)
+		return OHMD_S_INVALID_PARAMETER;
+
+	const preint_entry* ei = &me->entries[ring_index(me, i)];
+	const preint_entry* ej = &me->entries[ring_index(me, j)];
+	preint_entry rel;
+	mat3 R, tmp;
+
+	relative(ei, ej, &rel);
+
+	memset(out, 0, sizeof(ohmd_imu_preintegration));
+
+	out->start_time = ei->time;
+	out->end_time = ej->time;
+	out->num_samples = j - i;
+
+	for(int k = 0; k < 4; k++)
+		out->delta_rotation[k] = rel.rot.arr[k];
+
+	for(int k = 0; k < 3; k++){
+		out->delta_velocity[k] = rel.vel.arr[k];
+		out->delta_position[k] = rel.pos.arr[k];
+	}
+
+	// d(delta_R)/d(bg) = -delta_R^T * S
+	m3_from_quat(&rel.rot, R);
+	m3_mult_tn(R, rel.S, tmp);
+	m3_copy_out(tmp, -1.0f, out->d_rotation_d_gyro_bias);
+
+	m3_copy_out(rel.C, 1.0f, out->d_velocity_d_gyro_bias);
+	m3_copy_out(rel.A, -1.0f, out->d_velocity_d_accel_bias);
+	m3_copy_out(rel.G, 1.0f, out->d_position_d_gyro_bias);
+	m3_copy_out(rel.B, -1.0f, out->d_position_d_accel_bias);
+
+	// isotropic first order noise propagation, rotation noise couples into
+	// velocity and position through the mean specific force
+	float T = rel.tau;
+	float sg2 = POW2(me->gyro_noise), sa2 = POW2(me->accel_noise);
+	float f2 = T > 0 ? ovec3f_get_dot(&rel.vel, &rel.vel) / (T * T) : 0;
+
+	float rr = sg2 * T;
+	float vv = sa2 * T + f2 * sg2 * T * T * T / 3.0f;
+	float pp = sa2 * T * T * T / 3.0f + f2 * sg2 * powf(T, 5) / 20.0f;
+	float vp = sa2 * T * T / 2.0f + f2 * sg2 * powf(T, 4) / 8.0f;
+
+	for(int k = 0; k < 3; k++){
+		out->covariance[(0 + k) * 9 + (0 + k)] = rr;
+		out->covariance[(3 + k) * 9 + (3 + k)] = vv;
+		out->covariance[(6 + k) * 9 + (6 + k)] = pp;
+		out->covariance[(3 + k) * 9 + (6 + k)] = vp;
+		out->covariance[(6 + k) * 9 + (3 + k)] = vp;
+	}
+
+	return OHMD_S_OK;
+}
@@ -0,0 +1,49 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* IMU Pre-integration */
+
+
+#ifndef PREINT_H
+#define PREINT_H
+
+#include <stdbool.h>
+#include "openhmd.h"
+#include "omath.h"
+
+#define PREINT_MAX_SAMPLES 1024
+
+// cumulative integration state at one sample, relative to the current base entry
+typedef struct {
+	double time;  // host time of the sample, seconds
+	float tau;    // integrated time since the base entry
+
+	quatf rot;    // rotation from the base entry
+	vec3f vel;    // sum of R * a * dt
+	vec3f pos;    // sum of vel * dt + 0.5 * R * a * dt^2
+
+	// prefix sums for the bias jacobians
+	float S[3][3]; // sum of R(k+1) * dt
+	float A[3][3]; // sum of R * dt
+	float B[3][3]; // sum of A * dt + 0.5 * R * dt^2
+	float C[3][3]; // sum of [R * a]x * S * dt
+	float G[3][3]; // sum of C * dt + 0.5 * [R * a]x * S * dt^2
+} preint_entry;
+
+typedef struct {
+	preint_entry entries[PREINT_MAX_SAMPLES];
+	int head, count;
+	int since_rebase;
+
+	float gyro_noise;  // rad/s/sqrt(Hz)
+	float accel_noise; // m/s^2/sqrt(Hz)
+} imu_preint;
+
+void opreint_init(imu_preint* me);
+void opreint_add(imu_preint* me, double time, float dt, const vec3f* ang_vel, const vec3f* accel);
+ohmd_status opreint_get(const imu_preint* me, double t0, double t1, ohmd_imu_preintegration* out);
+
+#endif
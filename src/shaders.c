@@ -191,3 +191,301 @@ const char * const distortion_frag_es =
 	"//Black edges off the texture\n"
 	"gl_FragColor = ((tc_g.x < 0.0) || (tc_g.x > 1.0) || (tc_g.y < 0.0) || (tc_g.y > 1.0)) ? vec4(0.0, 0.0, 0.0, 1.0) : vec4(red, green, blue, 1.0);\n"
 "}";
+
+const char * const mesh_distortion_vert =
+"#version 120\n"
+"\n"
+"//vertices from ohmd_device_get_distortion_mesh\n"
+"attribute vec2 coords;\n"
+"attribute vec2 uv_red;\n"
+"attribute vec2 uv_green;\n"
+"attribute vec2 uv_blue;\n"
+"uniform mat4 mvp;\n"
+"varying vec2 tc_r;\n"
+"varying vec2 tc_g;\n"
+"varying vec2 tc_b;\n"
+"\n"
+"void main(void)\n"
+"{\n"
+    "tc_r = uv_red;\n"
+    "tc_g = uv_green;\n"
+    "tc_b = uv_blue;\n"
+    "gl_Position = mvp * vec4(coords, 0.0, 1.0);\n"
+"}";
+
+const char * const mesh_distortion_frag =
+"#version 120\n"
+"\n"
+"//per eye texture to warp for lens distortion\n"
+"uniform sampler2D warpTexture;\n"
+"\n"
+"//per channel source locations, distorted per vertex\n"
+"varying vec2 tc_r;\n"
+"varying vec2 tc_g;\n"
+"varying vec2 tc_b;\n"
+"\n"
+"void main()\n"
+"{\n"
+    "float red = texture2D(warpTexture, tc_r).r;\n"
+    "float green = texture2D(warpTexture, tc_g).g;\n"
+    "float blue = texture2D(warpTexture, tc_b).b;\n"
+    "//Black edges off the texture\n"
+    "gl_FragColor = ((tc_g.x < 0.0) || (tc_g.x > 1.0) || (tc_g.y < 0.0) || (tc_g.y > 1.0)) ? vec4(0.0, 0.0, 0.0, 1.0) : vec4(red, green, blue, 1.0);\n"
+"}";
+
+const char * const mesh_distortion_vert_330 =
+"#version 330\n"
+"\n"
+"//vertices from ohmd_device_get_distortion_mesh\n"
+"layout (location=0) in vec2 coords;\n"
+"layout (location=1) in vec2 uv_red;\n"
+"layout (location=2) in vec2 uv_green;\n"
+"layout (location=3) in vec2 uv_blue;\n"
+"uniform mat4 mvp;\n"
+"out vec2 tc_r;\n"
+"out vec2 tc_g;\n"
+"out vec2 tc_b;\n"
+"\n"
+"void main(void)\n"
+"{\n"
+    "tc_r = uv_red;\n"
+    "tc_g = uv_green;\n"
+    "tc_b = uv_blue;\n"
+    "gl_Position = mvp * vec4(coords, 0.0, 1.0);\n"
+"}";
+
+const char * const mesh_distortion_frag_330 =
+"#version 330\n"
+"\n"
+"//per eye texture to warp for lens distortion\n"
+"uniform sampler2D warpTexture;\n"
+"\n"
+"//per channel source locations, distorted per vertex\n"
+"in vec2 tc_r;\n"
+"in vec2 tc_g;\n"
+"in vec2 tc_b;\n"
+"out vec4 color;\n"
+"\n"
+"void main()\n"
+"{\n"
+    "float red = texture(warpTexture, tc_r).r;\n"
+    "float green = texture(warpTexture, tc_g).g;\n"
+    "float blue = texture(warpTexture, tc_b).b;\n"
+    "//Black edges off the texture\n"
+    "color = ((tc_g.x < 0.0) || (tc_g.x > 1.0) || (tc_g.y < 0.0) || (tc_g.y > 1.0)) ? vec4(0.0, 0.0, 0.0, 1.0) : vec4(red, green, blue, 1.0);\n"
+"}";
+
+const char * const mesh_distortion_vert_es =
+"#version 100\n"
+"\n"
+"//vertices from ohmd_device_get_distortion_mesh\n"
+"attribute vec2 coords;\n"
+"attribute vec2 uv_red;\n"
+"attribute vec2 uv_green;\n"
+"attribute vec2 uv_blue;\n"
+"uniform mat4 mvp;\n"
+"varying vec2 tc_r;\n"
+"varying vec2 tc_g;\n"
+"varying vec2 tc_b;\n"
+"\n"
+"void main(void)\n"
+"{\n"
+	"tc_r = uv_red;\n"
+	"tc_g = uv_green;\n"
+	"tc_b = uv_blue;\n"
+	"gl_Position = mvp * vec4(coords, 0.0, 1.0);\n"
+"}";
+
+const char * const mesh_distortion_frag_es =
+"#version 100\n"
+"precision mediump float;\n"
+"\n"
+"//per eye texture to warp for lens distortion\n"
+"uniform sampler2D warpTexture;\n"
+"\n"
+"//per channel source locations, distorted per vertex\n"
+"varying vec2 tc_r;\n"
+"varying vec2 tc_g;\n"
+"varying vec2 tc_b;\n"
+"\n"
+"void main()\n"
+"{\n"
+	"float red = texture2D(warpTexture, tc_r).r;\n"
+	"float green = texture2D(warpTexture, tc_g).g;\n"
+	"float blue = texture2D(warpTexture, tc_b).b;\n"
+	"//Black edges off the texture\n"
+	"gl_FragColor = ((tc_g.x < 0.0) || (tc_g.x > 1.0) || (tc_g.y < 0.0) || (tc_g.y > 1.0)) ? vec4(0.0, 0.0, 0.0, 1.0) : vec4(red, green, blue, 1.0);\n"
+"}";
+
+const char * const map_distortion_frag =
+"#version 120\n"
+"\n"
+"//per eye texture to warp for lens distortion\n"
+"uniform sampler2D warpTexture;\n"
+"//green channel source locations from ohmd_device_bake_distortion_map\n"
+"uniform sampler2D distortionMap;\n"
+"\n"
+"//Lens center in texture co-ords\n"
+"uniform vec2 LensCenterUV;\n"
+"//chromatic distortion post scaling relative to green\n"
+"uniform vec3 AberrRatio;\n"
+"//scale and offset from map values to texture co-ords\n"
+"uniform vec2 MapDecode;\n"
+"\n"
+"#define T gl_TexCoord[0].st\n"
+"\n"
+"void main()\n"
+"{\n"
+    "vec2 tc_g = texture2D(distortionMap, T).rg * MapDecode.x + MapDecode.y;\n"
+    "//aberration scales the displacement around the lens center\n"
+    "vec2 tc_r = LensCenterUV + AberrRatio.r * (tc_g - LensCenterUV);\n"
+    "vec2 tc_b = LensCenterUV + AberrRatio.b * (tc_g - LensCenterUV);\n"
+"\n"
+    "float red = texture2D(warpTexture, tc_r).r;\n"
+    "float green = texture2D(warpTexture, tc_g).g;\n"
+    "float blue = texture2D(warpTexture, tc_b).b;\n"
+    "//Black edges off the texture\n"
+    "gl_FragColor = ((tc_g.x < 0.0) || (tc_g.x > 1.0) || (tc_g.y < 0.0) || (tc_g.y > 1.0)) ? vec4(0.0, 0.0, 0.0, 1.0) : vec4(red, green, blue, 1.0);\n"
+"}";
+
+const char * const map_distortion_frag_330 =
+"#version 330\n"
+"\n"
+"//per eye texture to warp for lens distortion\n"
+"uniform sampler2D warpTexture;\n"
+"//green channel source locations from ohmd_device_bake_distortion_map\n"
+"uniform sampler2D distortionMap;\n"
+"\n"
+"//Lens center in texture co-ords\n"
+"uniform vec2 LensCenterUV;\n"
+"//chromatic distortion post scaling relative to green\n"
+"uniform vec3 AberrRatio;\n"
+"//scale and offset from map values to texture co-ords\n"
+"uniform vec2 MapDecode;\n"
+"\n"
+"in vec2 T;\n"
+"out vec4 color;\n"
+"\n"
+"void main()\n"
+"{\n"
+    "vec2 tc_g = texture(distortionMap, T).rg * MapDecode.x + MapDecode.y;\n"
+    "//aberration scales the displacement around the lens center\n"
+    "vec2 tc_r = LensCenterUV + AberrRatio.r * (tc_g - LensCenterUV);\n"
+    "vec2 tc_b = LensCenterUV + AberrRatio.b * (tc_g - LensCenterUV);\n"
+"\n"
+    "float red = texture(warpTexture, tc_r).r;\n"
+    "float green = texture(warpTexture, tc_g).g;\n"
+    "float blue = texture(warpTexture, tc_b).b;\n"
+    "//Black edges off the texture\n"
+    "color = ((tc_g.x < 0.0) || (tc_g.x > 1.0) || (tc_g.y < 0.0) || (tc_g.y > 1.0)) ? vec4(0.0, 0.0, 0.0, 1.0) : vec4(red, green, blue, 1.0);\n"
+"}";
+
+const char * const map_distortion_frag_es =
+"#version 100\n"
+"precision mediump float;\n"
+"\n"
+"//per eye texture to warp for lens distortion\n"
+"uniform sampler2D warpTexture;\n"
+"//green channel source locations from ohmd_device_bake_distortion_map\n"
+"uniform sampler2D distortionMap;\n"
+"\n"
+"//Lens center in texture co-ords\n"
+"uniform vec2 LensCenterUV;\n"
+"//chromatic distortion post scaling relative to green\n"
+"uniform vec3 AberrRatio;\n"
+"//scale and offset from map values to texture co-ords\n"
+"uniform vec2 MapDecode;\n"
+"\n"
+"varying vec2 T;\n"
+"\n"
+"void main()\n"
+"{\n"
+	"vec2 tc_g = texture2D(distortionMap, T).rg * MapDecode.x + MapDecode.y;\n"
+	"//aberration scales the displacement around the lens center\n"
+	"vec2 tc_r = LensCenterUV + AberrRatio.r * (tc_g - LensCenterUV);\n"
+	"vec2 tc_b = LensCenterUV + AberrRatio.b * (tc_g - LensCenterUV);\n"
+"\n"
+	"float red = texture2D(warpTexture, tc_r).r;\n"
+	"float green = texture2D(warpTexture, tc_g).g;\n"
+	"float blue = texture2D(warpTexture, tc_b).b;\n"
+	"//Black edges off the texture\n"
+	"gl_FragColor = ((tc_g.x < 0.0) || (tc_g.x > 1.0) || (tc_g.y < 0.0) || (tc_g.y > 1.0)) ? vec4(0.0, 0.0, 0.0, 1.0) : vec4(red, green, blue, 1.0);\n"
+"}";
+
+const char * const mesh_timewarp_vert =
+"#version 120\n"
+"\n"
+"//vertices from ohmd_device_get_distortion_mesh\n"
+"attribute vec2 coords;\n"
+"attribute vec2 uv_red;\n"
+"attribute vec2 uv_green;\n"
+"attribute vec2 uv_blue;\n"
+"uniform mat4 mvp;\n"
+"//reprojection from ohmd_device_get_timewarp_matrix\n"
+"uniform mat3 timewarp;\n"
+"varying vec2 tc_r;\n"
+"varying vec2 tc_g;\n"
+"varying vec2 tc_b;\n"
+"\n"
+"void main(void)\n"
+"{\n"
+    "vec3 r = timewarp * vec3(uv_red, 1.0);\n"
+    "vec3 g = timewarp * vec3(uv_green, 1.0);\n"
+    "vec3 b = timewarp * vec3(uv_blue, 1.0);\n"
+    "tc_r = r.xy / r.z;\n"
+    "tc_g = g.xy / g.z;\n"
+    "tc_b = b.xy / b.z;\n"
+    "gl_Position = mvp * vec4(coords, 0.0, 1.0);\n"
+"}";
+
+const char * const mesh_timewarp_vert_330 =
+"#version 330\n"
+"\n"
+"//vertices from ohmd_device_get_distortion_mesh\n"
+"layout (location=0) in vec2 coords;\n"
+"layout (location=1) in vec2 uv_red;\n"
+"layout (location=2) in vec2 uv_green;\n"
+"layout (location=3) in vec2 uv_blue;\n"
+"uniform mat4 mvp;\n"
+"//reprojection from ohmd_device_get_timewarp_matrix\n"
+"uniform mat3 timewarp;\n"
+"out vec2 tc_r;\n"
+"out vec2 tc_g;\n"
+"out vec2 tc_b;\n"
+"\n"
+"void main(void)\n"
+"{\n"
+    "vec3 r = timewarp * vec3(uv_red, 1.0);\n"
+    "vec3 g = timewarp * vec3(uv_green, 1.0);\n"
+    "vec3 b = timewarp * vec3(uv_blue, 1.0);\n"
+    "tc_r = r.xy / r.z;\n"
+    "tc_g = g.xy / g.z;\n"
+    "tc_b = b.xy / b.z;\n"
+    "gl_Position = mvp * vec4(coords, 0.0, 1.0);\n"
+"}";
+
+const char * const mesh_timewarp_vert_es =
+"#version 100\n"
+"\n"
+"//vertices from ohmd_device_get_distortion_mesh\n"
+"attribute vec2 coords;\n"
+"attribute vec2 uv_red;\n"
+"attribute vec2 uv_green;\n"
+"attribute vec2 uv_blue;\n"
+"uniform mat4 mvp;\n"
+"//reprojection from ohmd_device_get_timewarp_matrix\n"
+"uniform mat3 timewarp;\n"
+"varying vec2 tc_r;\n"
+"varying vec2 tc_g;\n"
+"varying vec2 tc_b;\n"
+"\n"
+"void main(void)\n"
+"{\n"
+	"vec3 r = timewarp * vec3(uv_red, 1.0);\n"
+	"vec3 g = timewarp * vec3(uv_green, 1.0);\n"
+	"vec3 b = timewarp * vec3(uv_blue, 1.0);\n"
+	"tc_r = r.xy / r.z;\n"
+	"tc_g = g.xy / g.z;\n"
+	"tc_b = b.xy / b.z;\n"
+	"gl_Position = mvp * vec4(coords, 0.0, 1.0);\n"
+"}";
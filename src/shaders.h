@@ -20,4 +20,21 @@ extern const char * const distortion_frag_330;
 extern const char * const distortion_vert_es;
 extern const char * const distortion_frag_es;
 
+extern const char * const mesh_distortion_vert;
+extern const char * const mesh_distortion_frag;
+
+extern const char * const mesh_distortion_vert_330;
+extern const char * const mesh_distortion_frag_330;
+
+extern const char * const mesh_distortion_vert_es;
+extern const char * const mesh_distortion_frag_es;
+
+extern const char * const map_distortion_frag;
+extern const char * const map_distortion_frag_330;
+extern const char * const map_distortion_frag_es;
+
+extern const char * const mesh_timewarp_vert;
+extern const char * const mesh_timewarp_vert_330;
+extern const char * const mesh_timewarp_vert_es;
+
 #endif /* SHADERS_H */
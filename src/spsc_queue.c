@@ -0,0 +1,64 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Single Producer, Single Consumer Queue Implementation */
+
+#include <string.h>
+#include "openhmdi.h"
+
+bool ospsc_queue_init(spsc_queue* me, ohmd_context* ctx, size_t entry_size, uint32_t capacity)
+{
+	memset(me, 0, sizeof(spsc_queue));
+
+	uint32_t size = 1;
+	while(size < capacity)
+		size <<= 1;
+
+	me->entries = ohmd_alloc(ctx, entry_size * size);
+	if(!me->entries)
+		return false;
+
+	me->entry_size = entry_size;
+	me->capacity = size;
+
+	return true;
+}
+
+void ospsc_queue_destroy(spsc_queue* me)
+{
+	free(me->entries);
+	me->entries = NULL;
+}
+
+bool ospsc_queue_push(spsc_queue* me, const void* entry)
+{
+	uint32_t head = me->head;
+	uint32_t tail = ohmd_atomic_load(&me->tail);
+
+	if(head - tail >= me->capacity){
+		ohmd_atomic_store(&me->dropped, me->dropped + 1);
+		return false;
+	}
+
+	memcpy(me->entries + (head & (me->capacity - 1)) * me->entry_size, entry, me->entry_size);
+	ohmd_atomic_store(&me->head, head + 1);
+
+	return true;
+}
+
+bool ospsc_queue_pop(spsc_queue* me, void* entry)
+{
+	uint32_t tail = me->tail;
+	uint32_t head = ohmd_atomic_load(&me->head);
+
+	if(head == tail)
+		return false;
+
+	memcpy(entry, me->entries + (tail & (me->capacity - 1)) * me->entry_size, me->entry_size);
+	ohmd_atomic_store(&me->tail, tail + 1);
+
+	return true;
+}
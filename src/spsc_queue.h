@@ -0,0 +1,44 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Single Producer, Single Consumer Queue */
+
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "openhmd.h"
+
+// fixed size entries handed from one thread to another without locks,
+// push and pop never block and never allocate
+typedef struct {
+	unsigned char* entries;
+	size_t entry_size;
+	uint32_t capacity; // power of two
+
+	// indices run freely and are masked, each is written by one side only
+	volatile uint32_t head; // producer
+	char pad0[60];
+	volatile uint32_t tail; // consumer
+	char pad1[60];
+
+	volatile uint32_t dropped; // entries not pushed because the queue was full, read with ohmd_atomic_load
+} spsc_queue;
+
+// capacity is rounded up to a power of two
+bool ospsc_queue_init(spsc_queue* me, ohmd_context* ctx, size_t entry_size, uint32_t capacity);
+void ospsc_queue_destroy(spsc_queue* me);
+
+// producer only, false if the queue is full
+bool ospsc_queue_push(spsc_queue* me, const void* entry);
+
+// consumer only, false if the queue is empty
+bool ospsc_queue_pop(spsc_queue* me, void* entry);
+
+#endif
@@ -0,0 +1,156 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Worker Thread Pool Implementation */
+
+/*
+ * The workers sleep on a condition variable between batches. A batch is a
+ * count of jobs, every thread including the caller takes the next job index
+ * until none are left, so a slow job doesn't hold up the others.
+ */
+
+#include "openhmdi.h"
+
+struct worker_pool {
+	ohmd_mutex* mutex;
+	ohmd_cond* work;  // a new batch or quit
+	ohmd_cond* done;  // the last worker left the batch
+
+	ohmd_thread* threads[WORKER_POOL_MAX_THREADS];
+	int num_threads;
+
+	// the current batch, protected by the mutex
+	worker_job_fn fn;
+	void* arg;
+	int count, next;
+	int busy;          // workers inside the batch
+	unsigned batch;    // counts batches so a worker joins each one once
+	bool quit;
+};
+
+// takes jobs until none are left, called and returns with the mutex held
+static void take_jobs(worker_pool* me)
+{
+	while(me->next < me->count){
+		int index = me->next++;
+		worker_job_fn fn = me->fn;
+		void* arg = me->arg;
+
+		ohmd_unlock_mutex(me->mutex);
+		fn(arg, index);
+		ohmd_lock_mutex(me->mutex);
+	}
+}
+
+static unsigned int worker_thread(void* arg)
+{
+	worker_pool* me = (worker_pool*)arg;
+	unsigned seen = 0;
+
+	ohmd_lock_mutex(me->mutex);
+
+	while(true){
+		while(!me->quit && me->batch == seen)
+			ohmd_cond_wait(me->work, me->mutex);
+
+		if(me->quit)
+			break;
+
+		seen = me->batch;
+
+		me->busy++;
+		take_jobs(me);
+		if(--me->busy == 0)
+			ohmd_cond_broadcast(me->done);
+	}
+
+	ohmd_unlock_mutex(me->mutex);
+
+	return 0;
+}
+
+worker_pool* oworker_pool_create(ohmd_context* ctx, int threads)
+{
+	worker_pool* me = ohmd_alloc(ctx, sizeof(worker_pool));
+	if(!me)
+		return NULL;
+
+	me->mutex = ohmd_create_mutex(ctx);
+	me->work = ohmd_create_cond(ctx);
+	me->done = ohmd_create_cond(ctx);
+
+	if(!me->mutex || !me->work || !me->done){
+		oworker_pool_destroy(me);
+		return NULL;
+	}
+
+	threads = OHMD_MIN(threads, WORKER_POOL_MAX_THREADS);
+	for(int i = 0; i < threads - 1; i++){
+		me->threads[me->num_threads] = ohmd_create_thread(ctx, worker_thread, me);
+		if(!me->threads[me->num_threads]){
+			LOGW("could only start %d of %d worker threads", me->num_threads, threads - 1);
+			break;
+		}
+
+		me->num_threads++;
+	}
+
+	return me;
+}
+
+void oworker_pool_destroy(worker_pool* me)
+{
+	if(me->mutex){
+		ohmd_lock_mutex(me->mutex);
+		me->quit = true;
+		if(me->work)
+			ohmd_cond_broadcast(me->work);
+		ohmd_unlock_mutex(me->mutex);
+	}
+
+	for(int i = 0; i < me->num_threads; i++)
+		ohmd_destroy_thread(me->threads[i]);
+
+	if(me->done)
+		ohmd_destroy_cond(me->done);
+	if(me->work)
+		ohmd_destroy_cond(me->work);
+	if(me->mutex)
+		ohmd_destroy_mutex(me->mutex);
+
+	free(me);
+}
+
+int oworker_pool_get_threads(const worker_pool* me)
+{
+	return me->num_threads + 1;
+}
+
+void oworker_pool_run(worker_pool* me, worker_job_fn fn, void* arg, int count)
+{
+	// not worth waking anyone
+	if(me->num_threads == 0 || count < 2){
+		for(int i = 0; i < count; i++)
+			fn(arg, i);
+		return;
+	}
+
+	ohmd_lock_mutex(me->mutex);
+
+	me->fn = fn;
+	me->arg = arg;
+	me->count = count;
+	me->next = 0;
+	me->batch++;
+	ohmd_cond_broadcast(me->work);
+
+	take_jobs(me);
+
+	while(me->busy > 0)
+		ohmd_cond_wait(me->done, me->mutex);
+
+	ohmd_unlock_mutex(me->mutex);
+}
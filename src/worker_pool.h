@@ -0,0 +1,29 @@
+// Copyright 2026, OpenHMD contributors.
+// SPDX-License-Identifier: BSL-1.0
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ */
+
+/* Worker Thread Pool */
+
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "openhmd.h"
+
+#define WORKER_POOL_MAX_THREADS 64
+
+typedef struct worker_pool worker_pool;
+
+typedef void (*worker_job_fn)(void* arg, int index);
+
+// threads counts the caller, so threads - 1 workers are started
+worker_pool* oworker_pool_create(ohmd_context* ctx, int threads);
+void oworker_pool_destroy(worker_pool* me);
+int oworker_pool_get_threads(const worker_pool* me);
+
+// runs fn(arg, 0 .. count - 1) on the workers and the caller, returns when all are done
+void oworker_pool_run(worker_pool* me, worker_job_fn fn, void* arg, int count);
+
+#endif
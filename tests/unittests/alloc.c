@@ -0,0 +1,157 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Allocation Tests */
+
+#include <stdlib.h>
+#include <string.h>
+#include "tests.h"
+
+/*
+ * With glibc the test binary replaces malloc, calloc and realloc, so every
+ * heap allocation made by the library, the drivers and their dependencies is
+ * counted while counting is on. Sanitizers bring their own allocator and
+ * other C libraries have no __libc_malloc, there the counts stay at zero.
+ */
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#define COUNT_ALLOCS 1
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+#endif
+
+static int counting;
+static int num_allocs;
+
+#if COUNT_ALLOCS
+static void count_alloc()
+{
+	if(__atomic_load_n(&counting, __ATOMIC_RELAXED))
+		__atomic_fetch_add(&num_allocs, 1, __ATOMIC_RELAXED);
+}
+
+void* malloc(size_t size)
+{
+	count_alloc();
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+	count_alloc();
+	return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+	count_alloc();
+	return __libc_realloc(ptr, size);
+}
+#endif
+
+static void start_counting()
+{
+	__atomic_store_n(&num_allocs, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&counting, 1, __ATOMIC_RELAXED);
+}
+
+static int stop_counting()
+{
+	__atomic_store_n(&counting, 0, __ATOMIC_RELAXED);
+	return __atomic_load_n(&num_allocs, __ATOMIC_RELAXED);
+}
+
+void test_omem_pool_recycle()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	mem_pool pool;
+	omem_pool_init(&pool, ctx, 40, 4);
+	TAssert(omem_pool_reserve(&pool, 10));
+	TAssert(pool.num_free == 10);
+
+	// reserved objects come without a heap allocation, zeroed and aligned
+	void* objs[10];
+	start_counting();
+	for(int i = 0; i < 10; i++){
+		objs[i] = omem_pool_alloc(&pool);
+		TAssert(objs[i]);
+		TAssert(((size_t)objs[i] & 15) == 0);
+		memset(objs[i], 0xff, 40);
+	}
+	TAssert(stop_counting() == 0);
+
+	for(int i = 0; i < 10; i++)
+		omem_pool_free(&pool, objs[i]);
+
+	// a freed object is handed out again
+	unsigned char* obj = omem_pool_alloc(&pool);
+	TAssert(obj == objs[9]);
+	for(int i = 0; i < 40; i++)
+		TAssert(obj[i] == 0);
+
+	// running out adds a chunk of per_chunk objects
+	for(int i = 0; i < 10; i++)
+		TAssert(omem_pool_alloc(&pool));
+	TAssert(pool.num_objects == 14 && pool.num_free == 3);
+
+	omem_pool_destroy(&pool);
+	ohmd_ctx_destroy(ctx);
+}
+
+static void update_devices(ohmd_context* ctx, ohmd_device* hmd, ohmd_device* ext, int frame)
+{
+	ohmd_sensor_sample samples[4];
+	for(int i = 0; i < 4; i++){
+		ohmd_sensor_sample s = {0, 0.001f, {0.3f, 1.0f, -0.2f}, {0, 9.81f, 0}, {0.3f, 0, -0.4f}};
+		samples[i] = s;
+	}
+
+	ohmd_sensor_samples batch = {samples, 4};
+	TAssert(ohmd_device_set_data(ext, OHMD_EXTERNAL_SENSOR_SAMPLES, &batch) == OHMD_S_OK);
+
+	ohmd_ctx_update(ctx);
+
+	float quat[4], pos[3];
+	TAssert(ohmd_device_getf(hmd, OHMD_ROTATION_QUAT, quat) == OHMD_S_OK);
+	TAssert(ohmd_device_getf(hmd, OHMD_POSITION_VECTOR, pos) == OHMD_S_OK);
+	TAssert(ohmd_device_getf(ext, OHMD_ROTATION_QUAT, quat) == OHMD_S_OK);
+	TAssert(ohmd_device_frame_event(hmd, OHMD_FRAME_BEGIN, frame * 0.011) == OHMD_S_OK);
+	TAssert(ohmd_device_frame_event(hmd, OHMD_FRAME_SUBMIT, frame * 0.011 + 0.005) == OHMD_S_OK);
+}
+
+void test_highlevel_update_no_alloc()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+	TAssert(ohmd_ctx_set_update_threads(ctx, 2) == OHMD_S_OK);
+
+	ohmd_device_settings* settings = ohmd_device_settings_create(ctx);
+	int manual = 0;
+	ohmd_device_settings_seti(settings, OHMD_IDS_AUTOMATIC_UPDATE, &manual);
+
+	ohmd_device* hmd = open_product(ctx, "HMD Null Device", settings);
+	ohmd_device* ext = open_product(ctx, "External Device", settings);
+	TAssert(hmd && ext);
+
+	// warm up, the update groups and the worker threads are set up here
+	for(int i = 0; i < 10; i++)
+		update_devices(ctx, hmd, ext, i);
+
+	// after that updating and reading the devices never goes to the heap
+	start_counting();
+	for(int i = 10; i < 1000; i++)
+		update_devices(ctx, hmd, ext, i);
+	int allocs = stop_counting();
+	if(allocs)
+		printf("\n%d allocations during update", allocs);
+	TAssert(allocs == 0);
+
+	ohmd_device_settings_destroy(settings);
+	ohmd_ctx_destroy(ctx);
+}
@@ -0,0 +1,49 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Clock Synchronization Tests */
+
+#include "tests.h"
+
+void test_oclock_sync_drift_and_wrap()
+{
+	uint32_t seed = 12345;
+
+	// 1 MHz device clock with a 24 bit counter that wraps every ~16.7 s,
+	// running 300 ppm fast and started 12.3 s after the host clock
+	const double drift = 300e-6, offset = 12.3, min_latency = 0.0005;
+	clock_sync cs;
+	oclock_sync_init(&cs, 1000000.0, 24);
+
+	double max_err = 0;
+
+	for(int i = 0; i < 40000; i++){
+		double host = offset + i * 0.001;
+		uint64_t ticks = (uint64_t)((host - offset) * (1.0 + drift) * 1000000.0 + 5000000);
+
+		// usb + scheduling latency, occasionally very late
+		double latency = min_latency + 0.004 * test_rand(&seed);
+		if(i % 97 == 0)
+			latency += 0.05;
+
+		double est = oclock_sync_update(&cs, ticks & 0xffffff, host + latency);
+
+		// past the warm-up the estimate only carries the minimum latency
+		if(i > 10000){
+			double err = fabs(est - (host + min_latency));
+			if(err > max_err)
+				max_err = err;
+		}
+	}
+
+	TAssert(max_err < 0.0003);
+	TAssert(float_eq(cs.drift, -drift, 50e-6));
+
+	// mapping a sample tick from before the last update
+	double host = offset + 39999 * 0.001 - 0.002;
+	uint64_t ticks = (uint64_t)((host - offset) * (1.0 + drift) * 1000000.0 + 5000000);
+	TAssert(fabs(oclock_sync_to_host(&cs, ticks & 0xffffff) - (host + min_latency)) < 0.0003);
+}
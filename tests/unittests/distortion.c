@@ -0,0 +1,535 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Distortion Tests */
+
+#include <string.h>
+#include "tests.h"
+
+// straight port of the universal distortion fragment shader, for one channel
+static void shader_warp(const distortion_params* p, float u, float v, float aberr, float* out)
+{
+	float rx = (u * p->viewport_scale[0] - p->lens_center[0]) / p->warp_scale;
+	float ry = (v * p->viewport_scale[1] - p->lens_center[1]) / p->warp_scale;
+	float r_mag = sqrtf(rx * rx + ry * ry);
+	float k = p->warp_param[3] + p->warp_param[2] * r_mag +
+		p->warp_param[1] * r_mag * r_mag + p->warp_param[0] * r_mag * r_mag * r_mag;
+
+	out[0] = (p->lens_center[0] + aberr * rx * k * p->warp_scale) / p->viewport_scale[0];
+	out[1] = (p->lens_center[1] + aberr * ry * k * p->warp_scale) / p->viewport_scale[1];
+}
+
+void test_odistortion_mesh()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	ohmd_device* hmd = ohmd_list_open_device(ctx, num_devices - 1);
+	TAssert(hmd);
+
+	ohmd_set_universal_distortion_k(&hmd->properties, 0.098f, 0.324f, -0.241f, 0.819f);
+	ohmd_set_universal_aberration_k(&hmd->properties, 0.995f, 1.0f, 1.005f);
+
+	ohmd_distortion_mesh mesh;
+	TAssert(ohmd_device_get_distortion_mesh(hmd, OHMD_EYE_LEFT, 0, 16, &mesh) == OHMD_S_INVALID_PARAMETER);
+	TAssert(ohmd_device_get_distortion_mesh(hmd, OHMD_EYE_RIGHT, 32, 16, &mesh) == OHMD_S_OK);
+	TAssert(mesh.num_vertices == 33 * 17);
+	TAssert(mesh.num_indices == 6 * 32 * 16);
+
+	for(int i = 0; i < mesh.num_indices; i++)
+		TAssert(mesh.indices[i] < (unsigned int)mesh.num_vertices);
+
+	distortion_params p;
+	odistortion_get_params(hmd, OHMD_EYE_RIGHT, &p);
+
+	for(int i = 0; i < mesh.num_vertices; i += 7){
+		const ohmd_distortion_vertex* vtx = mesh.vertices + i;
+		float r[2], g[2], b[2];
+		shader_warp(&p, vtx->coords[0], vtx->coords[1], 0.995f, r);
+		shader_warp(&p, vtx->coords[0], vtx->coords[1], 1.0f, g);
+		shader_warp(&p, vtx->coords[0], vtx->coords[1], 1.005f, b);
+
+		TAssert(float_eq(vtx->uv_red[0], r[0], 1e-5f) && float_eq(vtx->uv_red[1], r[1], 1e-5f));
+		TAssert(float_eq(vtx->uv_green[0], g[0], 1e-5f) && float_eq(vtx->uv_green[1], g[1], 1e-5f));
+		TAssert(float_eq(vtx->uv_blue[0], b[0], 1e-5f) && float_eq(vtx->uv_blue[1], b[1], 1e-5f));
+	}
+
+	// cached until the properties change
+	const ohmd_distortion_vertex* first = mesh.vertices;
+	float before = mesh.vertices[0].uv_green[0];
+	TAssert(ohmd_device_get_distortion_mesh(hmd, OHMD_EYE_RIGHT, 32, 16, &mesh) == OHMD_S_OK);
+	TAssert(mesh.vertices == first && mesh.vertices[0].uv_green[0] == before);
+
+	hmd->properties.lens_sep += 0.002f;
+	TAssert(ohmd_device_get_distortion_mesh(hmd, OHMD_EYE_RIGHT, 32, 16, &mesh) == OHMD_S_OK);
+	TAssert(mesh.vertices[0].uv_green[0] != before);
+
+	TAssert(ohmd_close_device(hmd) == 0);
+	ohmd_ctx_destroy(ctx);
+}
+
+void test_odistortion_bake_map()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	ohmd_device* hmd = ohmd_list_open_device(ctx, num_devices - 1);
+	TAssert(hmd);
+
+	ohmd_set_universal_distortion_k(&hmd->properties, 0.098f, 0.324f, -0.241f, 0.819f);
+	ohmd_set_universal_aberration_k(&hmd->properties, 0.995f, 1.0f, 1.005f);
+
+	// big enough to be split over threads
+	const int w = 512, h = 384;
+	float* map = malloc(sizeof(float) * w * h * 2);
+	uint16_t* map16 = malloc(sizeof(uint16_t) * w * h * 2);
+	TAssert(map && map16);
+
+	ohmd_distortion_map_info info, info16;
+	TAssert(ohmd_device_bake_distortion_map(hmd, OHMD_EYE_LEFT, w, h, OHMD_DISTORTION_MAP_FLOAT32, map, &info) == OHMD_S_OK);
+	TAssert(ohmd_device_bake_distortion_map(hmd, OHMD_EYE_LEFT, w, h, OHMD_DISTORTION_MAP_UNORM16, map16, &info16) == OHMD_S_OK);
+
+	distortion_params p;
+	odistortion_get_params(hmd, OHMD_EYE_LEFT, &p);
+
+	for(int y = 0; y < h; y += 13){
+		for(int x = 0; x < w; x += 11){
+			float u = (x + 0.5f) / w, v = (y + 0.5f) / h;
+			float r[2], g[2];
+			shader_warp(&p, u, v, 0.995f, r);
+			shader_warp(&p, u, v, 1.0f, g);
+
+			const float* t = map + (y * w + x) * 2;
+			TAssert(float_eq(t[0], g[0], 1e-5f) && float_eq(t[1], g[1], 1e-5f));
+
+			// red as the map shader derives it
+			for(int i = 0; i < 2; i++)
+				TAssert(float_eq(info.lens_center[i] + info.aberr_ratio[0] * (t[i] - info.lens_center[i]), r[i], 1e-5f));
+
+			// 16-bit storage is good to a fraction of a texel, where it is on the texture
+			const uint16_t* t16 = map16 + (y * w + x) * 2;
+			for(int i = 0; i < 2; i++){
+				float decoded = t16[i] / 65535.0f * info16.decode[0] + info16.decode[1];
+				if(g[i] > info16.decode[1] && g[i] < info16.decode[0] + info16.decode[1])
+					TAssert(float_eq(decoded, g[i], 1e-4f));
+			}
+		}
+	}
+
+	TAssert(ohmd_device_bake_distortion_map(hmd, OHMD_EYE_LEFT, w, h, OHMD_DISTORTION_MAP_FLOAT16, map16, NULL) == OHMD_S_OK);
+	TAssert(map16[0] != 0);
+	TAssert(ohmd_device_bake_distortion_map(hmd, OHMD_EYE_LEFT, 0, h, OHMD_DISTORTION_MAP_FLOAT32, map, NULL) == OHMD_S_INVALID_PARAMETER);
+
+	free(map);
+	free(map16);
+
+	TAssert(ohmd_close_device(hmd) == 0);
+	ohmd_ctx_destroy(ctx);
+}
+
+static bool in_mesh(const ohmd_area_mesh* mesh, float x, float y)
+{
+	for(int i = 0; i < mesh->num_indices; i += 3){
+		const float* a = mesh->vertices + mesh->indices[i + 0] * 2;
+		const float* b = mesh->vertices + mesh->indices[i + 1] * 2;
+		const float* c = mesh->vertices + mesh->indices[i + 2] * 2;
+
+		float d0 = (b[0] - a[0]) * (y - a[1]) - (b[1] - a[1]) * (x - a[0]);
+		float d1 = (c[0] - b[0]) * (y - b[1]) - (c[1] - b[1]) * (x - b[0]);
+		float d2 = (a[0] - c[0]) * (y - c[1]) - (a[1] - c[1]) * (x - c[0]);
+
+		if((d0 >= 0 && d1 >= 0 && d2 >= 0) || (d0 <= 0 && d1 <= 0 && d2 <= 0))
+			return true;
+	}
+
+	return false;
+}
+
+static float mesh_area(const ohmd_area_mesh* mesh)
+{
+	float area = 0;
+	for(int i = 0; i < mesh->num_indices; i += 3){
+		const float* a = mesh->vertices + mesh->indices[i + 0] * 2;
+		const float* b = mesh->vertices + mesh->indices[i + 1] * 2;
+		const float* c = mesh->vertices + mesh->indices[i + 2] * 2;
+		area += fabsf((b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0])) / 2;
+	}
+
+	return area;
+}
+
+void test_odistortion_area_mesh()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	ohmd_device* hmd = ohmd_list_open_device(ctx, num_devices - 1);
+	TAssert(hmd);
+
+	ohmd_set_universal_distortion_k(&hmd->properties, 0.098f, 0.324f, -0.241f, 0.819f);
+	ohmd_set_universal_aberration_k(&hmd->properties, 0.995f, 1.0f, 1.005f);
+
+	ohmd_area_mesh hidden, visible;
+	TAssert(ohmd_device_get_area_mesh(hmd, OHMD_EYE_LEFT, OHMD_HIDDEN_AREA_MESH, 64, &hidden) == OHMD_S_OK);
+	TAssert(ohmd_device_get_area_mesh(hmd, OHMD_EYE_LEFT, OHMD_VISIBLE_AREA_MESH, 64, &visible) == OHMD_S_OK);
+	TAssert(ohmd_device_get_area_mesh(hmd, OHMD_EYE_LEFT, OHMD_VISIBLE_AREA_MESH, 2, &visible) == OHMD_S_INVALID_PARAMETER);
+	TAssert(ohmd_device_get_area_mesh(hmd, OHMD_EYE_LEFT, OHMD_VISIBLE_AREA_MESH, 64, &visible) == OHMD_S_OK);
+
+	float hidden_area = mesh_area(&hidden);
+	TAssert(hidden_area > 0.01f && hidden_area < 0.5f);
+
+	distortion_params p;
+	odistortion_get_params(hmd, OHMD_EYE_LEFT, &p);
+
+	// no channel of any pixel samples the hidden area, every pixel sampling the texture is in the visible area
+	for(int y = 0; y < 100; y++){
+		for(int x = 0; x < 100; x++){
+			float u = (x + 0.5f) / 100, v = (y + 0.5f) / 100;
+			float tc[3][2];
+			shader_warp(&p, u, v, 0.995f, tc[0]);
+			shader_warp(&p, u, v, 1.0f, tc[1]);
+			shader_warp(&p, u, v, 1.005f, tc[2]);
+
+			bool on_texture = tc[1][0] >= 0 && tc[1][0] <= 1 && tc[1][1] >= 0 && tc[1][1] <= 1;
+			if(on_texture){
+				TAssert(in_mesh(&visible, u, v));
+				for(int c = 0; c < 3; c++)
+					TAssert(!in_mesh(&hidden, tc[c][0], tc[c][1]));
+			}
+		}
+	}
+
+	TAssert(ohmd_close_device(hmd) == 0);
+	ohmd_ctx_destroy(ctx);
+}
+
+void test_odistortion_frustum()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	ohmd_device* hmd = ohmd_list_open_device(ctx, num_devices - 1);
+	TAssert(hmd);
+
+	float left[4], right[4];
+	TAssert(ohmd_device_getf(hmd, OHMD_LEFT_EYE_FRUSTUM_TANGENTS, left) == OHMD_S_OK);
+	TAssert(ohmd_device_getf(hmd, OHMD_RIGHT_EYE_FRUSTUM_TANGENTS, right) == OHMD_S_OK);
+
+	// same extent as the default projection, split around the lens center
+	float half_tan = tanf(hmd->properties.fov / 2.0f);
+	TAssert(float_eq(left[0] + left[1], 2.0f * hmd->properties.ratio * half_tan, 1e-5f));
+	TAssert(float_eq(left[2] + left[3], 2.0f * half_tan, 1e-5f));
+
+	// the lenses sit towards the nose, so the outer side sees further, mirrored between the eyes
+	TAssert(left[0] > left[1]);
+	TAssert(float_eq(left[0], right[1], 1e-5f) && float_eq(left[1], right[0], 1e-5f));
+	TAssert(float_eq(left[2], right[2], 1e-5f) && float_eq(left[3], right[3], 1e-5f));
+
+	// no distortion gives one texel per display pixel, magnification at the lens center asks for more
+	int w, h;
+	TAssert(ohmd_device_get_render_target_size(hmd, 1.0f, &w, &h) == OHMD_S_OK);
+	TAssert(w == hmd->properties.hres / 2 && h == hmd->properties.vres);
+
+	ohmd_set_universal_distortion_k(&hmd->properties, 0.098f, 0.324f, -0.241f, 0.8f);
+	TAssert(ohmd_device_get_render_target_size(hmd, 1.0f, &w, &h) == OHMD_S_OK);
+	TAssert(w == (int)ceilf(hmd->properties.hres / 2 / 0.8f) && h == (int)ceilf(hmd->properties.vres / 0.8f));
+	TAssert(ohmd_device_get_render_target_size(hmd, 0, &w, &h) == OHMD_S_INVALID_PARAMETER);
+
+	TAssert(ohmd_close_device(hmd) == 0);
+	ohmd_ctx_destroy(ctx);
+}
+
+void test_odistortion_points()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	ohmd_device* hmd = ohmd_list_open_device(ctx, num_devices - 1);
+	TAssert(hmd);
+
+	ohmd_set_universal_distortion_k(&hmd->properties, 0.098f, 0.324f, -0.241f, 0.819f);
+	ohmd_set_universal_aberration_k(&hmd->properties, 0.995f, 1.0f, 1.005f);
+
+	const int n = 21;
+	float in[21 * 21 * 2], tex[21 * 21 * 2], back[21 * 21 * 2];
+	for(int y = 0; y < n; y++){
+		for(int x = 0; x < n; x++){
+			in[(y * n + x) * 2 + 0] = x / (float)(n - 1);
+			in[(y * n + x) * 2 + 1] = y / (float)(n - 1);
+		}
+	}
+
+	for(int eye = 0; eye < 2; eye++){
+		distortion_params p;
+		odistortion_get_params(hmd, (ohmd_eye)eye, &p);
+
+		for(int ch = 0; ch < 3; ch++){
+			TAssert(ohmd_device_distort_points(hmd, (ohmd_eye)eye, (ohmd_color_channel)ch, n * n, in, tex) == OHMD_S_OK);
+			TAssert(ohmd_device_undistort_points(hmd, (ohmd_eye)eye, (ohmd_color_channel)ch, n * n, tex, back) == OHMD_S_OK);
+
+			for(int i = 0; i < n * n; i++){
+				float expected[2];
+				shader_warp(&p, in[i * 2], in[i * 2 + 1], p.aberr[ch], expected);
+				TAssert(float_eq(tex[i * 2], expected[0], 1e-5f) && float_eq(tex[i * 2 + 1], expected[1], 1e-5f));
+				TAssert(float_eq(back[i * 2], in[i * 2], 1e-5f) && float_eq(back[i * 2 + 1], in[i * 2 + 1], 1e-5f));
+			}
+		}
+	}
+
+	// in place
+	memcpy(back, in, sizeof(in));
+	TAssert(ohmd_device_distort_points(hmd, OHMD_EYE_LEFT, OHMD_CHANNEL_GREEN, n * n, back, back) == OHMD_S_OK);
+	ohmd_device_distort_points(hmd, OHMD_EYE_LEFT, OHMD_CHANNEL_GREEN, n * n, in, tex);
+	TAssert(memcmp(back, tex, sizeof(tex)) == 0);
+
+	TAssert(ohmd_device_distort_points(hmd, OHMD_EYE_LEFT, (ohmd_color_channel)3, 1, in, tex) == OHMD_S_INVALID_PARAMETER);
+	TAssert(ohmd_device_undistort_points(hmd, (ohmd_eye)2, OHMD_CHANNEL_RED, 1, in, tex) == OHMD_S_INVALID_PARAMETER);
+
+	TAssert(ohmd_close_device(hmd) == 0);
+	ohmd_ctx_destroy(ctx);
+}
+
+// applies a column major homography to a texture coordinate
+static void warp_uv(const float* m, float u, float v, float* out)
+{
+	float x = m[0] * u + m[3] * v + m[6];
+	float y = m[1] * u + m[4] * v + m[7];
+	float w = m[2] * u + m[5] * v + m[8];
+	out[0] = x / w;
+	out[1] = y / w;
+}
+
+void test_odistortion_timewarp()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	ohmd_device* hmd = ohmd_list_open_device(ctx, num_devices - 1);
+	TAssert(hmd);
+
+	float tan[4];
+	TAssert(ohmd_device_getf(hmd, OHMD_LEFT_EYE_FRUSTUM_TANGENTS, tan) == OHMD_S_OK);
+	const float w = tan[0] + tan[1], h = tan[2] + tan[3];
+	const float cu = tan[0] / w, cv = tan[2] / h; // optical axis
+
+	// rendered with the current pose nothing moves
+	float rot[4], m[9];
+	ohmd_ctx_update(ctx);
+	TAssert(ohmd_device_getf(hmd, OHMD_ROTATION_QUAT, rot) == OHMD_S_OK);
+	TAssert(ohmd_device_get_timewarp_matrix(hmd, OHMD_EYE_LEFT, rot, ohmd_get_time(), m) == OHMD_S_OK);
+	for(int i = 0; i < 9; i++)
+		TAssert(float_eq(m[i], i % 4 == 0 ? 1.0f : 0.0f, 1e-5f));
+
+	// rendered looking left, straight ahead now is to the right in the frame
+	const float angle = 0.2f;
+	vec3f up = {{0, 1, 0}};
+	quatf yaw;
+	oquatf_init_axis(&yaw, &up, angle);
+	TAssert(ohmd_device_get_timewarp_matrix(hmd, OHMD_EYE_LEFT, yaw.arr, ohmd_get_time(), m) == OHMD_S_OK);
+
+	float uv[2];
+	warp_uv(m, cu, cv, uv);
+	TAssert(float_eq(uv[0], (tanf(angle) + tan[0]) / w, 1e-5f));
+	TAssert(float_eq(uv[1], cv, 1e-5f));
+
+	// a direction up and to the left lands where a pinhole camera of the rendered view would put it
+	float tx = -0.3f, ty = 0.2f;
+	vec3f dir = {{tx, ty, -1}}, in_render;
+	quatf inv = yaw;
+	oquatf_inverse(&inv);
+	oquatf_get_rotated(&inv, &dir, &in_render);
+	warp_uv(m, (tx + tan[0]) / w, (ty + tan[2]) / h, uv);
+	TAssert(float_eq(uv[0], (in_render.x / -in_render.z + tan[0]) / w, 1e-5f));
+	TAssert(float_eq(uv[1], (in_render.y / -in_render.z + tan[2]) / h, 1e-5f));
+
+	// turning left at 1 rad/s, a frame shown 50 ms after the last sample needs the head turned 0.05 rad further
+	fusion f;
+	ofusion_init(&f);
+	double now = ohmd_get_time();
+	vec3f gyro = {{0, 1.0f, 0}}, accel = {{0, 9.81f, 0}}, mag = {{0, 0, -1}};
+	ofusion_set_sample_time(&f, now);
+	ofusion_update(&f, 0.001f, &gyro, &accel, &mag);
+	hmd->fusion = &f;
+
+	TAssert(ohmd_device_get_timewarp_matrix(hmd, OHMD_EYE_LEFT, rot, now + 0.05, m) == OHMD_S_OK);
+	warp_uv(m, cu, cv, uv);
+	TAssert(float_eq(uv[0], (tan[0] - tanf(0.05f)) / w, 1e-4f));
+
+	// far ahead the extrapolation is capped
+	TAssert(ohmd_device_get_timewarp_matrix(hmd, OHMD_EYE_LEFT, rot, now + 10.0, m) == OHMD_S_OK);
+	warp_uv(m, cu, cv, uv);
+	TAssert(float_eq(uv[0], (tan[0] - tanf(0.1f)) / w, 1e-4f));
+
+	hmd->fusion = NULL;
+
+	TAssert(ohmd_device_get_timewarp_matrix(hmd, (ohmd_eye)2, rot, now, m) == OHMD_S_INVALID_PARAMETER);
+
+	TAssert(ohmd_close_device(hmd) == 0);
+	ohmd_ctx_destroy(ctx);
+}
+
+void test_odistortion_shading_rate_map()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	ohmd_device* hmd = ohmd_list_open_device(ctx, num_devices - 1);
+	TAssert(hmd);
+
+	ohmd_set_universal_distortion_k(&hmd->properties, 0.098f, 0.324f, -0.241f, 0.819f);
+	ohmd_set_universal_aberration_k(&hmd->properties, 0.995f, 1.0f, 1.005f);
+
+	const int w = 40, h = 50;
+	const float quality = 0.8f;
+	unsigned char map[40 * 50];
+	TAssert(ohmd_device_get_shading_rate_map(hmd, OHMD_EYE_LEFT, w, h, 1.5f, map) == OHMD_S_INVALID_PARAMETER);
+	TAssert(ohmd_device_get_shading_rate_map(hmd, OHMD_EYE_LEFT, w, h, quality, map) == OHMD_S_OK);
+
+	distortion_params p;
+	odistortion_get_params(hmd, OHMD_EYE_LEFT, &p);
+
+	// full rate at the lens center, something coarser towards the edges
+	int cx = (int)(p.lens_center[0] / p.viewport_scale[0] * w), cy = (int)(p.lens_center[1] / p.viewport_scale[1] * h);
+	TAssert(map[cy * w + cx] == 0);
+
+	int coarse = 0;
+	for(int i = 0; i < w * h; i++){
+		TAssert(map[i] == 0x0 || map[i] == 0x1 || map[i] == 0x4 || map[i] == 0x5 || map[i] == 0x6 || map[i] == 0x9 || map[i] == 0xa);
+		coarse += map[i] != 0;
+	}
+	TAssert(coarse > 0);
+
+	// every screen pixel's texel must be shaded at least as densely as the numerical derivative of the warp asks for
+	const float eps = 1e-3f;
+	for(int y = 0; y < 100; y++){
+		for(int x = 0; x < 100; x++){
+			float u = (x + 0.5f) / 100, v = (y + 0.5f) / 100;
+			float tc[2], tu[2], tv[2];
+			shader_warp(&p, u, v, 1.0f, tc);
+			if(tc[0] < 0 || tc[0] >= 1 || tc[1] < 0 || tc[1] >= 1)
+				continue;
+
+			shader_warp(&p, u + eps, v, 1.0f, tu);
+			shader_warp(&p, u, v + eps, 1.0f, tv);
+
+			// jacobian of texture over screen position, both in metres
+			float j00 = (tu[0] - tc[0]) / eps, j10 = (tu[1] - tc[1]) * p.viewport_scale[1] / (eps * p.viewport_scale[0]);
+			float j01 = (tv[0] - tc[0]) * p.viewport_scale[0] / (eps * p.viewport_scale[1]), j11 = (tv[1] - tc[1]) / eps;
+			float det = j00 * j11 - j01 * j10;
+
+			// screen distance per texel step along each texture axis, relative to the lens center
+			float k0 = p.warp_param[3] * p.aberr[1];
+			float need_x = k0 * sqrtf(POW2(j11 / det) + POW2(-j10 / det));
+			float need_y = k0 * sqrtf(POW2(-j01 / det) + POW2(j00 / det));
+
+			unsigned char rate = map[(int)(tc[1] * h) * w + (int)(tc[0] * w)];
+			TAssert((1 << (rate >> 2)) * need_x * quality <= 1.02f);
+			TAssert((1 << (rate & 3)) * need_y * quality <= 1.02f);
+		}
+	}
+
+	TAssert(ohmd_close_device(hmd) == 0);
+	ohmd_ctx_destroy(ctx);
+}
+
+static float clamp_texel(float tc)
+{
+	float t = tc * 256 - 0.5f;
+	return t < 0 ? 0 : (t > 255 ? 255 : t);
+}
+
+void test_odistortion_composite()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	ohmd_device* hmd = ohmd_list_open_device(ctx, num_devices - 1);
+	TAssert(hmd);
+
+	ohmd_set_universal_distortion_k(&hmd->properties, 0.098f, 0.324f, -0.241f, 0.819f);
+	ohmd_set_universal_aberration_k(&hmd->properties, 0.99f, 1.0f, 1.01f);
+
+	// linear ramps, so bilinear filtering reproduces the sample position exactly
+	static unsigned char eye_pixels[256 * 256 * 4];
+	for(int y = 0; y < 256; y++){
+		for(int x = 0; x < 256; x++){
+			unsigned char* px = eye_pixels + (y * 256 + x) * 4;
+			px[0] = x;
+			px[1] = y;
+			px[2] = 255 - x;
+			px[3] = 255;
+		}
+	}
+
+	ohmd_rgba_image eye = { eye_pixels, 256, 256, 256 * 4 };
+
+	// big enough to be split over threads
+	const int pw = 640, ph = 400;
+	ohmd_rgba_image panel = { malloc(pw * ph * 4), pw, ph, pw * 4 };
+	TAssert(panel.pixels);
+
+	TAssert(ohmd_device_composite(hmd, &eye, NULL, &panel) == OHMD_S_INVALID_PARAMETER);
+	TAssert(ohmd_device_composite(hmd, &eye, &eye, &panel) == OHMD_S_OK);
+
+	for(int e = 0; e < 2; e++){
+		distortion_params p;
+		odistortion_get_params(hmd, e, &p);
+
+		for(int y = 0; y < ph; y += 3){
+			for(int x = 0; x < pw / 2; x += 3){
+				float u = (x + 0.5f) / (pw / 2), v = (y + 0.5f) / ph;
+				float r[2], g[2], b[2];
+				shader_warp(&p, u, v, 0.99f, r);
+				shader_warp(&p, u, v, 1.0f, g);
+				shader_warp(&p, u, v, 1.01f, b);
+
+				const unsigned char* px = panel.pixels + y * panel.stride + (e * pw / 2 + x) * 4;
+				TAssert(px[3] == 255);
+
+				// skip the rounding ambiguity right at the edge
+				if(fabsf(g[0]) < 1e-3f || fabsf(g[0] - 1) < 1e-3f || fabsf(g[1]) < 1e-3f || fabsf(g[1] - 1) < 1e-3f)
+					continue;
+
+				if(g[0] < 0 || g[0] > 1 || g[1] < 0 || g[1] > 1){
+					TAssert(px[0] == 0 && px[1] == 0 && px[2] == 0);
+				} else {
+					TAssert(fabsf(px[0] - clamp_texel(r[0])) <= 1.0f);
+					TAssert(fabsf(px[1] - clamp_texel(g[1])) <= 1.0f);
+					TAssert(fabsf(px[2] - (255 - clamp_texel(b[0]))) <= 1.0f);
+				}
+			}
+		}
+	}
+
+	free(panel.pixels);
+
+	TAssert(ohmd_close_device(hmd) == 0);
+	ohmd_ctx_destroy(ctx);
+}
@@ -0,0 +1,64 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Frame Timing Tests */
+
+#include <math.h>
+#include "tests.h"
+
+void test_oframe_timing_vsync()
+{
+	uint32_t seed = 4321;
+
+	// 90 Hz panel, 6-8 ms of rendering, every 10th frame misses its vblank, scanout 2 vblanks after the frame is done
+	const double period = 1.0 / 90.0;
+	frame_timing ft;
+	oframe_timing_init(&ft);
+
+	double vblank = 100.0;
+	for(int i = 0; i < 200; i++){
+		double begin = vblank + 0.0005;
+		double render = 0.006 + 0.002 * test_rand(&seed);
+
+		// the prediction for the frame that just began must land on the vblank it will be shown at
+		oframe_timing_begin(&ft, begin);
+		double predicted = oframe_timing_predict(&ft, begin + 0.001);
+
+		double submit = begin + render;
+		double shown = vblank + (i % 10 == 9 ? 3 : 2) * period;
+
+		if(i > 30 && i % 10 != 9)
+			TAssert(fabs(predicted - shown) < 1e-6);
+
+		oframe_timing_submit(&ft, submit);
+		oframe_timing_present(&ft, shown);
+
+		vblank += (i % 10 == 9 ? 2 : 1) * period;
+	}
+
+	TAssert(fabs(oframe_timing_get_period(&ft) - period) < 1e-6);
+	TAssert(oframe_timing_get_render_time(&ft) > 0.006 && oframe_timing_get_render_time(&ft) < 0.008);
+}
+
+void test_oframe_timing_no_present()
+{
+	// without presents the submit rate gives the period and frames show a period after submit
+	const double period = 1.0 / 72.0;
+	frame_timing ft;
+	oframe_timing_init(&ft);
+	TAssert(fabs(oframe_timing_get_period(&ft) - 1.0 / 90.0) < 1e-9);
+
+	double t = 5.0;
+	for(int i = 0; i < 50; i++){
+		oframe_timing_begin(&ft, t);
+		oframe_timing_submit(&ft, t + 0.004);
+		t += period;
+	}
+
+	TAssert(fabs(oframe_timing_get_period(&ft) - period) < 1e-9);
+	TAssert(fabs(oframe_timing_get_latency(&ft) - period) < 1e-9);
+	TAssert(fabs(oframe_timing_predict(&ft, t) - (t + 0.004 + period)) < 1e-9);
+}
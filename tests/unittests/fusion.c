@@ -0,0 +1,200 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Sensor Fusion Tests */
+
+#include "tests.h"
+
+void test_ofusion_eskf_gyro_bias()
+{
+	// a level device sitting still with a biased gyro, the bias on the
+	// tilt axes must be estimated and the orientation must not drift
+	fusion f;
+	ofusion_init(&f);
+	ofusion_set_engine(&f, FUSION_ENGINE_ESKF);
+
+	vec3f bias = {{0.02f, 0.0f, -0.015f}};
+	vec3f accel = {{0.0f, 9.82f, 0.0f}};
+	vec3f mag = {{0.0f, 0.0f, 0.0f}};
+
+	for(int i = 0; i < 20000; i++)
+		ofusion_update(&f, 0.001f, &bias, &accel, &mag);
+
+	TAssert(float_eq(f.eskf.gyro_bias.x, bias.x, 0.002f));
+	TAssert(float_eq(f.eskf.gyro_bias.z, bias.z, 0.002f));
+
+	vec3f up = {{0.0f, 1.0f, 0.0f}}, world_up;
+	oquatf_get_rotated(&f.orient, &up, &world_up);
+	TAssert(float_eq(world_up.y, 1.0f, 0.001f));
+
+	TAssert(float_eq(f.ang_vel.x, 0.0f, 0.002f));
+	TAssert(float_eq(f.ang_vel.z, 0.0f, 0.002f));
+}
+
+void test_ofusion_eskf_initial_tilt()
+{
+	// the first sample sets the tilt straight away
+	fusion f;
+	ofusion_init(&f);
+	ofusion_set_engine(&f, FUSION_ENGINE_ESKF);
+
+	vec3f gyro = {{0.0f, 0.0f, 0.0f}};
+	vec3f accel = {{9.82f * sinf(0.5f), 9.82f * cosf(0.5f), 0.0f}};
+	vec3f mag = {{0.0f, 0.0f, 0.0f}};
+
+	for(int i = 0; i < 10; i++)
+		ofusion_update(&f, 0.001f, &gyro, &accel, &mag);
+
+	vec3f world_accel;
+	oquatf_get_rotated(&f.orient, &accel, &world_accel);
+	TAssert(vec3f_eq(world_accel, (vec3f){{0.0f, 9.82f, 0.0f}}, 0.01f));
+}
+
+static void integrate(const vec3f* gyro, const vec3f* accel, int from, int to, float dt, vec3f bias,
+                      quatf* rot, vec3f* vel, vec3f* pos)
+{
+	*rot = (quatf){{0, 0, 0, 1.0f}};
+	*vel = (vec3f){{0, 0, 0}};
+	*pos = (vec3f){{0, 0, 0}};
+
+	for(int k = from + 1; k <= to; k++){
+		vec3f wa, w;
+		oquatf_get_rotated(rot, &accel[k], &wa);
+
+		for(int i = 0; i < 3; i++){
+			pos->arr[i] += vel->arr[i] * dt + 0.5f * wa.arr[i] * dt * dt;
+			vel->arr[i] += wa.arr[i] * dt;
+		}
+
+		ovec3f_subtract(&gyro[k], &bias, &w);
+		float len = ovec3f_get_length(&w);
+		quatf delta;
+		oquatf_init_axis(&delta, &w, len * dt);
+		oquatf_mult_me(rot, &delta);
+		oquatf_normalize_me(rot);
+	}
+}
+
+// angle of the rotation between two quaternions
+static float quat_angle(const quatf* a, const quatf* b)
+{
+	quatf d;
+	oquatf_diff(a, b, &d);
+	return 2.0f * sqrtf(d.x * d.x + d.y * d.y + d.z * d.z);
+}
+
+void test_opreint_get()
+{
+	static imu_preint preint;
+	static vec3f gyro[3000], accel[3000];
+	const float dt = 0.001f;
+	const int count = 3000;
+
+	opreint_init(&preint);
+
+	for(int k = 0; k < count; k++){
+		float t = k * dt;
+		gyro[k] = (vec3f){{0.8f * sinf(3.0f * t), 1.2f * cosf(2.0f * t), 0.5f * sinf(5.0f * t + 1.0f)}};
+		accel[k] = (vec3f){{2.0f * cosf(4.0f * t), 9.82f + sinf(t), -1.5f * sinf(6.0f * t)}};
+		opreint_add(&preint, 100.0 + t, dt, &gyro[k], &accel[k]);
+	}
+
+	// the window starts before the last rebase and ends after it
+	int from = 2000, to = 2200;
+	ohmd_imu_preintegration out;
+	TAssert(opreint_get(&preint, 100.0 + from * dt, 100.0 + to * dt + 0.0002, &out) == OHMD_S_OK);
+	TAssert(out.num_samples == to - from);
+
+	quatf rot;
+	vec3f vel, pos, zero = {{0, 0, 0}};
+	integrate(gyro, accel, from, to, dt, zero, &rot, &vel, &pos);
+
+	TAssert(vec3f_eq((vec3f){{out.delta_velocity[0], out.delta_velocity[1], out.delta_velocity[2]}}, vel, 0.001f));
+	TAssert(vec3f_eq((vec3f){{out.delta_position[0], out.delta_position[1], out.delta_position[2]}}, pos, 0.0001f));
+	TAssert(quat_angle(&rot, (quatf*)out.delta_rotation) < 1e-4f);
+
+	// first order bias correction must match re-integrating with a gyro bias
+	vec3f bias = {{0.002f, -0.001f, 0.0015f}};
+	quatf rot_b;
+	vec3f vel_b, pos_b;
+	integrate(gyro, accel, from, to, dt, bias, &rot_b, &vel_b, &pos_b);
+
+	for(int i = 0; i < 3; i++){
+		float dv = 0, dp = 0;
+		for(int j = 0; j < 3; j++){
+			dv += out.d_velocity_d_gyro_bias[i * 3 + j] * bias.arr[j];
+			dp += out.d_position_d_gyro_bias[i * 3 + j] * bias.arr[j];
+		}
+		TAssert(float_eq(vel.arr[i] + dv, vel_b.arr[i], 1e-4f));
+		TAssert(float_eq(pos.arr[i] + dp, pos_b.arr[i], 1e-5f));
+	}
+
+	vec3f d_theta = {{0, 0, 0}};
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+			d_theta.arr[i] += out.d_rotation_d_gyro_bias[i * 3 + j] * bias.arr[j];
+
+	quatf corr, rot_c;
+	oquatf_init_axis(&corr, &d_theta, ovec3f_get_length(&d_theta));
+	oquatf_mult(&rot, &corr, &rot_c);
+	TAssert(quat_angle(&rot_c, &rot_b) < 0.1f * quat_angle(&rot, &rot_b));
+
+	// samples that have left the buffer can't be queried
+	TAssert(opreint_get(&preint, 100.0, 100.0 + to * dt, &out) == OHMD_S_INVALID_PARAMETER);
+}
+
+void test_ofusion_external_samples()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	ohmd_device* single = open_product(ctx, "External Device", NULL);
+	ohmd_device* batched = open_product(ctx, "External Device", NULL);
+	ohmd_device* timed = open_product(ctx, "External Device", NULL);
+	TAssert(single && batched && timed);
+
+	const int count = 500;
+	ohmd_sensor_sample samples[500];
+	ohmd_sensor_sample stamped[500];
+
+	for(int i = 0; i < count; i++){
+		ohmd_sensor_sample s = {0, 0.001f, {0.3f, 1.0f, -0.2f}, {0, 9.81f, 0}, {0.3f, 0, -0.4f}};
+		samples[i] = s;
+
+		float in[10] = {s.dt, s.gyro[0], s.gyro[1], s.gyro[2], s.accel[0], s.accel[1], s.accel[2], s.mag[0], s.mag[1], s.mag[2]};
+		TAssert(ohmd_device_setf(single, OHMD_EXTERNAL_SENSOR_FUSION, in) == OHMD_S_OK);
+
+		// absolute timestamps with only the first sample carrying a dt
+		stamped[i] = s;
+		stamped[i].time = 10.0 + (i + 1) * 0.001;
+		stamped[i].dt = i == 0 ? 0.001f : 0;
+	}
+
+	ohmd_sensor_samples batch = {samples, count};
+	TAssert(ohmd_device_set_data(batched, OHMD_EXTERNAL_SENSOR_SAMPLES, &batch) == OHMD_S_OK);
+
+	// a repeated sample must not integrate again
+	ohmd_sensor_samples timed_batch = {stamped, count};
+	ohmd_sensor_samples repeat = {stamped + count - 1, 1};
+	TAssert(ohmd_device_set_data(timed, OHMD_EXTERNAL_SENSOR_SAMPLES, &timed_batch) == OHMD_S_OK);
+	TAssert(ohmd_device_set_data(timed, OHMD_EXTERNAL_SENSOR_SAMPLES, &repeat) == OHMD_S_OK);
+
+	ohmd_sensor_samples bad = {NULL, 3};
+	TAssert(ohmd_device_set_data(batched, OHMD_EXTERNAL_SENSOR_SAMPLES, &bad) == OHMD_S_INVALID_PARAMETER);
+
+	ohmd_ctx_update(ctx);
+
+	quatf rot_single, rot_batched, rot_timed;
+	TAssert(ohmd_device_getf(single, OHMD_ROTATION_QUAT, rot_single.arr) == OHMD_S_OK);
+	TAssert(ohmd_device_getf(batched, OHMD_ROTATION_QUAT, rot_batched.arr) == OHMD_S_OK);
+	TAssert(ohmd_device_getf(timed, OHMD_ROTATION_QUAT, rot_timed.arr) == OHMD_S_OK);
+
+	TAssert(quat_angle(&rot_single, &rot_batched) < 1e-6f);
+	TAssert(quat_angle(&rot_single, &rot_timed) < 1e-3f);
+	TAssert(quat_angle(&rot_single, &(quatf){{0, 0, 0, 1}}) > 0.3f);
+
+	ohmd_ctx_destroy(ctx);
+}
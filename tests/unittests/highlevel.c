@@ -7,9 +7,24 @@
 
 /* Unit Tests - High-level functions */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "tests.h"
+#include <stdlib.h>
+#include <string.h>
 #include "openhmd.h"
 
+ohmd_device* open_product(ohmd_context* ctx, const char* product, ohmd_device_settings* settings)
+{
+	int num_devices = ohmd_ctx_probe(ctx);
+	for(int i = 0; i < num_devices; i++){
+		if(strcmp(ohmd_list_gets(ctx, i, OHMD_PRODUCT), product) == 0)
+			return settings ? ohmd_list_open_device_s(ctx, i, settings) : ohmd_list_open_device(ctx, i);
+	}
+
+	return NULL;
+}
+
 void test_highlevel_open_close_device()
 {
 	ohmd_context* ctx = ohmd_ctx_create();
@@ -67,3 +82,402 @@ void test_highlevel_open_close_many_devices()
 	
 	ohmd_ctx_destroy(ctx);	
 }
+
+void test_highlevel_device_registries()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	// the list grows past its initial capacity and keeps what was added
+	ohmd_device_list list = {0};
+	list.ctx = ctx;
+	for(int i = 0; i < 100; i++){
+		ohmd_device_desc* desc = ohmd_device_list_add(&list);
+		TAssert(desc && desc->id == 0);
+		desc->id = i;
+	}
+	TAssert(list.num_devices == 100);
+	for(int i = 0; i < 100; i++)
+		TAssert(list.devices[i].id == i);
+	free(list.devices);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+	TAssert(ohmd_list_gets(ctx, -1, OHMD_PRODUCT) == NULL);
+
+	ohmd_device_settings* settings = ohmd_device_settings_create(ctx);
+	int manual = 0;
+	ohmd_device_settings_seti(settings, OHMD_IDS_AUTOMATIC_UPDATE, &manual);
+
+	// more than fitted the old fixed array, closing from the middle keeps the other handles working
+	ohmd_device* hmds[300];
+	for(int i = 0; i < 300; i++){
+		hmds[i] = ohmd_list_open_device_s(ctx, num_devices - 1, settings);
+		TAssert(hmds[i]);
+	}
+
+	for(int i = 0; i < 300; i += 3)
+		TAssert(ohmd_close_device(hmds[i]) == 0);
+
+	TAssert(ctx->num_active_devices == 200);
+	for(int i = 0; i < 300; i++){
+		if(i % 3 == 0)
+			continue;
+
+		TAssert(ctx->active_devices[hmds[i]->active_device_idx] == hmds[i]);
+	}
+
+	ohmd_ctx_update(ctx);
+
+	float quat[4];
+	TAssert(ohmd_device_getf(hmds[299], OHMD_ROTATION_QUAT, quat) == OHMD_S_OK);
+
+	ohmd_device_settings_destroy(settings);
+	ohmd_ctx_destroy(ctx);
+}
+
+typedef struct {
+	ohmd_mutex* mutex;
+	int ready, failed;
+} open_counts;
+
+static void count_open(ohmd_open_request* request, ohmd_open_state state, ohmd_device* device, void* user_data)
+{
+	open_counts* counts = (open_counts*)user_data;
+
+	ohmd_lock_mutex(counts->mutex);
+	if(state == OHMD_OPEN_READY && device)
+		counts->ready++;
+	else
+		counts->failed++;
+	ohmd_unlock_mutex(counts->mutex);
+}
+
+void test_highlevel_open_device_async()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	TAssert(ohmd_list_open_device_async(ctx, num_devices, NULL, NULL, NULL) == NULL);
+
+	open_counts counts = {ohmd_create_mutex(ctx), 0, 0};
+
+	// a few devices of one driver and all the others at once
+	ohmd_open_request* requests[16];
+	int num_requests = 0;
+	for(int i = 0; i < num_devices && num_requests < 12; i++)
+		requests[num_requests++] = ohmd_list_open_device_async(ctx, i, NULL, count_open, &counts);
+	for(int i = 0; i < 4; i++)
+		requests[num_requests++] = ohmd_list_open_device_async(ctx, num_devices - 1, NULL, count_open, &counts);
+
+	for(int i = 0; i < num_requests; i++)
+		TAssert(requests[i]);
+
+	// wait for all of them by polling
+	for(int tries = 0; tries < 1000; tries++){
+		int pending = 0;
+		for(int i = 0; i < num_requests; i++)
+			pending += ohmd_open_request_poll(requests[i], NULL) == OHMD_OPEN_PENDING;
+
+		if(!pending)
+			break;
+
+		ohmd_sleep(0.01);
+	}
+
+	ohmd_device* last = NULL;
+	int ready = 0;
+	for(int i = 0; i < num_requests; i++){
+		ohmd_device* device = NULL;
+		ohmd_open_state state = ohmd_open_request_poll(requests[i], &device);
+		TAssert(state != OHMD_OPEN_PENDING);
+		TAssert((state == OHMD_OPEN_READY) == (device != NULL));
+
+		if(device){
+			ready++;
+			last = device;
+		}
+
+		ohmd_open_request_destroy(requests[i]);
+	}
+
+	// the callbacks ran before the requests were done with
+	TAssert(counts.ready == ready && counts.ready + counts.failed == num_requests);
+	TAssert(ready >= 4 && ctx->num_active_devices == ready);
+
+	float quat[4];
+	ohmd_ctx_update(ctx);
+	TAssert(ohmd_device_getf(last, OHMD_ROTATION_QUAT, quat) == OHMD_S_OK);
+	TAssert(ohmd_close_device(last) == 0);
+
+	ohmd_destroy_mutex(counts.mutex);
+	ohmd_ctx_destroy(ctx);
+}
+
+static void failing_get_device_list(ohmd_driver* driver, ohmd_device_list* list)
+{
+	ohmd_device_desc* desc = ohmd_device_list_add(list);
+	strcpy(desc->driver, "Failing Driver");
+	strcpy(desc->product, "Failing Device");
+	strcpy(desc->path, "(failing)");
+	desc->driver_ptr = driver;
+}
+
+static ohmd_device* failing_open_device(ohmd_driver* driver, ohmd_device_desc* desc)
+{
+	return NULL;
+}
+
+static void failing_destroy(ohmd_driver* driver)
+{
+	free(driver);
+}
+
+void test_highlevel_open_device_async_error()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	ohmd_driver* driver = ohmd_alloc(ctx, sizeof(ohmd_driver));
+	driver->get_device_list = failing_get_device_list;
+	driver->open_device = failing_open_device;
+	driver->destroy = failing_destroy;
+	driver->ctx = ctx;
+	ohmd_add_driver(ctx, driver);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	int index = -1;
+	for(int i = 0; i < num_devices; i++){
+		if(strcmp(ohmd_list_gets(ctx, i, OHMD_PRODUCT), "Failing Device") == 0)
+			index = i;
+	}
+	TAssert(index >= 0);
+
+	// the failure is kept with the request, the context error is left alone
+	ohmd_open_request* req = ohmd_list_open_device_async(ctx, index, NULL, NULL, NULL);
+	TAssert(req);
+
+	for(int tries = 0; tries < 1000 && ohmd_open_request_poll(req, NULL) == OHMD_OPEN_PENDING; tries++)
+		ohmd_sleep(0.01);
+
+	TAssert(ohmd_open_request_poll(req, NULL) == OHMD_OPEN_FAILED);
+	TAssert(strstr(ohmd_open_request_get_error(req), "Failing Device"));
+	TAssert(strcmp(ohmd_ctx_get_error(ctx), "") == 0);
+	ohmd_open_request_destroy(req);
+
+	// opening in the foreground still sets it
+	TAssert(ohmd_list_open_device(ctx, index) == NULL);
+	TAssert(strstr(ohmd_ctx_get_error(ctx), "Failing Device"));
+
+	ohmd_ctx_destroy(ctx);
+}
+
+void test_highlevel_open_device_async_update()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	// manually updated devices go into the update groups ohmd_ctx_update rebuilds
+	ohmd_device_settings* settings = ohmd_device_settings_create(ctx);
+	int manual = 0;
+	ohmd_device_settings_seti(settings, OHMD_IDS_AUTOMATIC_UPDATE, &manual);
+	TAssert(ohmd_ctx_set_update_threads(ctx, 4) == OHMD_S_OK);
+
+	// enough devices to grow the active device list, each opened while updating
+	ohmd_open_request* requests[64];
+	for(int i = 0; i < 64; i++){
+		requests[i] = ohmd_list_open_device_async(ctx, num_devices - 1, settings, NULL, NULL);
+		TAssert(requests[i]);
+		ohmd_ctx_update(ctx);
+	}
+
+	int pending = 64;
+	for(int tries = 0; tries < 1000000 && pending; tries++){
+		ohmd_ctx_update(ctx);
+
+		pending = 0;
+		for(int i = 0; i < 64; i++)
+			pending += ohmd_open_request_poll(requests[i], NULL) == OHMD_OPEN_PENDING;
+	}
+	TAssert(!pending);
+
+	// the devices all share one connection and end up in one group
+	ohmd_ctx_update(ctx);
+	TAssert(ctx->num_active_devices == 64);
+	TAssert(ctx->num_update_groups == 1 && ctx->update_groups[1] == 64);
+
+	for(int i = 0; i < 64; i++)
+		ohmd_open_request_destroy(requests[i]);
+
+	ohmd_device_settings_destroy(settings);
+	ohmd_ctx_destroy(ctx);
+}
+
+typedef struct {
+	ohmd_context* ctx;
+	volatile uint32_t quit;
+} update_loop;
+
+static unsigned int run_updates(void* arg)
+{
+	update_loop* loop = (update_loop*)arg;
+
+	while(!ohmd_atomic_load(&loop->quit))
+		ohmd_ctx_update(loop->ctx);
+
+	return 0;
+}
+
+void test_highlevel_close_while_updating()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices > 0);
+
+	ohmd_device_settings* settings = ohmd_device_settings_create(ctx);
+	int manual = 0;
+	ohmd_device_settings_seti(settings, OHMD_IDS_AUTOMATIC_UPDATE, &manual);
+	TAssert(ohmd_ctx_set_update_threads(ctx, 2) == OHMD_S_OK);
+
+	// the dummy devices have controls, so every update also queues into them
+	ohmd_device* devices[16];
+	for(int i = 0; i < 16; i++){
+		devices[i] = ohmd_list_open_device_s(ctx, i % num_devices, settings);
+		TAssert(devices[i]);
+	}
+
+	// the groups run without the update lock, closing must wait for them and not leave them stale
+	update_loop loop = {ctx, 0};
+	ohmd_thread* thread = ohmd_create_thread(ctx, run_updates, &loop);
+	TAssert(thread);
+
+	for(int i = 0; i < 16; i++){
+		ohmd_sleep(0.001);
+		TAssert(ohmd_close_device(devices[i]) == OHMD_S_OK);
+	}
+
+	ohmd_atomic_store(&loop.quit, 1);
+	ohmd_destroy_thread(thread);
+
+	TAssert(ctx->num_active_devices == 0);
+
+	ohmd_device_settings_destroy(settings);
+	ohmd_ctx_destroy(ctx);
+}
+
+void test_highlevel_driver_selection()
+{
+	TAssert(oplugin_driver_allowed("vive"));
+
+	setenv(OHMD_DRIVERS_ENV, "rift-s, external", 1);
+	TAssert(oplugin_driver_allowed("external"));
+	TAssert(oplugin_driver_allowed("rift-s"));
+	TAssert(!oplugin_driver_allowed("rift"));
+	TAssert(!oplugin_driver_allowed("dummy"));
+
+	// drivers that aren't listed are never created
+	setenv(OHMD_DRIVERS_ENV, "external", 1);
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	int num_devices = ohmd_ctx_probe(ctx);
+	TAssert(num_devices >= 1);
+	for(int i = 0; i < num_devices; i++)
+		TAssert(strcmp(ohmd_list_gets(ctx, i, OHMD_PRODUCT), "External Device") == 0);
+
+	ohmd_ctx_destroy(ctx);
+	unsetenv(OHMD_DRIVERS_ENV);
+}
+
+static float fake_controls[3];
+
+static int fake_controls_getf(ohmd_device* device, ohmd_float_value type, float* out)
+{
+	if(type != OHMD_CONTROLS_STATE)
+		return OHMD_S_INVALID_PARAMETER;
+
+	memcpy(out, fake_controls, sizeof(fake_controls));
+	return OHMD_S_OK;
+}
+
+void test_highlevel_control_events()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	ohmd_device_settings* settings = ohmd_device_settings_create(ctx);
+	int manual = 0;
+	ohmd_device_settings_seti(settings, OHMD_IDS_AUTOMATIC_UPDATE, &manual);
+
+	ohmd_device* dummy = open_product(ctx, "HMD Null Device", settings);
+	TAssert(dummy);
+
+	// the core picks up the changes of drivers that don't report them
+	ohmd_control_event events[300];
+	int count = -1;
+	TAssert(ohmd_device_get_control_events(dummy, events, 300, &count) == OHMD_S_OK && count == 0);
+	TAssert(ohmd_device_get_control_events(dummy, events, -1, &count) == OHMD_S_INVALID_PARAMETER);
+
+	double before = ohmd_get_time();
+	ohmd_ctx_update(ctx);
+	TAssert(ohmd_device_get_control_events(dummy, events, 300, &count) == OHMD_S_OK && count == 2);
+	TAssert(events[0].control == 0 && float_eq(events[0].value, 0.1f, 1e-6f));
+	TAssert(events[1].control == 1 && events[1].value == 1.0f);
+	TAssert(events[0].time >= before && events[0].device_time == 0);
+
+	ohmd_ctx_update(ctx);
+	TAssert(ohmd_device_get_control_events(dummy, events, 300, &count) == OHMD_S_OK && count == 0);
+
+	// but leaves the queue to drivers that report while decoding, they may decode on another thread
+	dummy->control_values[0] = 0;
+	dummy->reports_controls = true;
+	ohmd_ctx_update(ctx);
+	TAssert(ohmd_device_get_control_events(dummy, events, 300, &count) == OHMD_S_OK && count == 0);
+	dummy->reports_controls = false;
+
+	// a press and release between two reads come out as two events
+	ohmd_device fake;
+	memset(&fake, 0, sizeof(fake));
+	fake.ctx = ctx;
+	fake.getf = fake_controls_getf;
+	fake.properties.control_count = 3;
+	TAssert(ospsc_queue_init(&fake.control_events, ctx, sizeof(ohmd_control_event), 256));
+
+	fake_controls[1] = 1.0f;
+	ohmd_device_report_controls(&fake, 1.5, 10.0);
+	fake_controls[1] = 0.0f;
+	ohmd_device_report_controls(&fake, 1.6, 10.1);
+	ohmd_device_report_controls(&fake, 1.7, 10.2);
+
+	TAssert(ohmd_device_get_control_events(&fake, events, 300, &count) == OHMD_S_OK && count == 2);
+	TAssert(events[0].control == 1 && events[0].value == 1.0f && events[0].device_time == 1.5 && events[0].time == 10.0);
+	TAssert(events[1].control == 1 && events[1].value == 0.0f && events[1].device_time == 1.6 && events[1].time == 10.1);
+
+	// a full queue keeps the oldest changes, the latest state follows once drained
+	for(int i = 1; i <= 300; i++){
+		fake_controls[2] = (float)i;
+		ohmd_device_report_controls(&fake, 0, i);
+	}
+	TAssert(ohmd_device_get_control_events(&fake, events, 300, &count) == OHMD_S_OK && count == 256);
+	TAssert(events[0].value == 1.0f && events[255].value == 256.0f);
+
+	ohmd_device_report_controls(&fake, 0, 301);
+	TAssert(ohmd_device_get_control_events(&fake, events, 300, &count) == OHMD_S_OK && count == 1);
+	TAssert(events[0].control == 2 && events[0].value == 300.0f);
+
+	ospsc_queue_destroy(&fake.control_events);
+
+	// devices without controls have no queue
+	TAssert(ohmd_device_get_control_events(&fake, events, 300, &count) == OHMD_S_UNSUPPORTED);
+
+	ohmd_device_settings_destroy(settings);
+	ohmd_ctx_destroy(ctx);
+}
@@ -15,6 +15,12 @@ bool float_eq(float a, float b, float t)
 	return fabsf(a - b) < t;
 }
 
+double test_rand(uint32_t* state)
+{
+	*state = *state * 1103515245 + 12345;
+	return ((*state >> 8) & 0xffff) / 65536.0;
+}
+
 #define Test(_t) printf("   "#_t); _t(); printf("%*sok\n", 50 - (int)strlen(#_t), "");
 
 int main()
@@ -34,9 +40,72 @@ int main()
 	Test(test_oquatf_diff);
 	printf("\n");
 
+	printf("fusion tests\n");
+	Test(test_ofusion_eskf_gyro_bias);
+	Test(test_ofusion_eskf_initial_tilt);
+	Test(test_ofusion_external_samples);
+	Test(test_opreint_get);
+	printf("\n");
+
+	printf("clock sync tests\n");
+	Test(test_oclock_sync_drift_and_wrap);
+	printf("\n");
+
+	printf("pose filter tests\n");
+	Test(test_opose_filter_jitter_and_lag);
+	Test(test_opose_filter_rotation);
+	printf("\n");
+
+	printf("position filter tests\n");
+	Test(test_oposition_filter_fusion);
+	printf("\n");
+
+	printf("frame timing tests\n");
+	Test(test_oframe_timing_vsync);
+	Test(test_oframe_timing_no_present);
+	printf("\n");
+
+	printf("worker pool tests\n");
+	Test(test_oworker_pool_run);
+	Test(test_oworker_pool_ctx_update);
+	printf("\n");
+
+	printf("shared memory tests\n");
+	Test(test_oshm_publish_and_read);
+	Test(test_oshm_external_ring);
+	printf("\n");
+
+	printf("distortion tests\n");
+	Test(test_odistortion_mesh);
+	Test(test_odistortion_bake_map);
+	Test(test_odistortion_area_mesh);
+	Test(test_odistortion_frustum);
+	Test(test_odistortion_timewarp);
+	Test(test_odistortion_points);
+	Test(test_odistortion_shading_rate_map);
+	Test(test_odistortion_composite);
+	printf("\n");
+
 	printf("high level tests\n");
 	Test(test_highlevel_open_close_device);
 	Test(test_highlevel_open_close_many_devices);
+	Test(test_highlevel_device_registries);
+	Test(test_highlevel_open_device_async);
+	Test(test_highlevel_open_device_async_update);
+	Test(test_highlevel_open_device_async_error);
+	Test(test_highlevel_close_while_updating);
+	Test(test_highlevel_driver_selection);
+	Test(test_highlevel_control_events);
+	printf("\n");
+
+	printf("allocation tests\n");
+	Test(test_omem_pool_recycle);
+	Test(test_highlevel_update_no_alloc);
+	printf("\n");
+
+	printf("spsc queue tests\n");
+	Test(test_ospsc_queue_push_pop);
+	Test(test_ospsc_queue_threads);
 	printf("\n");
 
 	printf("all a-ok\n");
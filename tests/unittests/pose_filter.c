@@ -0,0 +1,77 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Pose Filter Tests */
+
+#include "tests.h"
+
+void test_opose_filter_jitter_and_lag()
+{
+	uint32_t seed = 4321;
+
+	// 1 kHz positional source with +-2 mm of noise
+	const float noise = 0.002f, dt = 0.001f;
+	pose_filter pf;
+	opose_filter_init(&pf);
+	pf.pos_params = (one_euro_params){ 1.0f, 20.0f, 1.0f };
+
+	// at rest the jitter must be reduced considerably
+	double in_sq = 0, out_sq = 0;
+	for(int i = 0; i < 2000; i++){
+		vec3f p = {{noise * (float)(2 * test_rand(&seed) - 1), 1.0f, 0}};
+		vec3f in = p;
+		opose_filter_position(&pf, i * dt, &p);
+
+		if(i >= 1000){
+			in_sq += POW2(in.x);
+			out_sq += POW2(p.x);
+		}
+	}
+
+	TAssert(sqrt(out_sq / 1000) < 0.2 * sqrt(in_sq / 1000));
+
+	// moving at 1 m/s the added latency must stay small
+	float lag = 0;
+	for(int i = 0; i < 1000; i++){
+		float x = i * dt;
+		vec3f p = {{x + noise * (float)(2 * test_rand(&seed) - 1), 1.0f, 0}};
+		opose_filter_position(&pf, 2.0 + i * dt, &p);
+
+		if(i >= 500)
+			lag += (x - p.x) / 500.0f;
+	}
+
+	TAssert(lag > 0 && lag < 0.015f);
+}
+
+void test_opose_filter_rotation()
+{
+	// rotating at 1 rad/s about Y the filtered rotation must follow closely
+	pose_filter pf;
+	opose_filter_init(&pf);
+	pf.rot_params = (one_euro_params){ 1.0f, 5.0f, 1.0f };
+
+	vec3f up = {{0, 1.0f, 0}};
+	quatf q;
+
+	for(int i = 0; i < 2000; i++){
+		oquatf_init_axis(&q, &up, i * 0.001f);
+		opose_filter_rotation(&pf, i * 0.001, &q);
+	}
+
+	quatf truth, diff;
+	oquatf_init_axis(&truth, &up, 1999 * 0.001f);
+	oquatf_diff(&q, &truth, &diff);
+
+	float err = 2.0f * sqrtf(POW2(diff.x) + POW2(diff.y) + POW2(diff.z));
+	TAssert(err > 0 && err < 0.05f);
+
+	// disabled filters pass the input through
+	pf.rot_params.min_cutoff = 0;
+	quatf in = q = (quatf){{0, 0, 0, 1.0f}};
+	opose_filter_rotation(&pf, 3.0, &q);
+	TAssert(q.w == in.w);
+}
@@ -0,0 +1,64 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Position Filter Tests */
+
+#include <math.h>
+#include "tests.h"
+
+void test_oposition_filter_fusion()
+{
+	uint32_t seed = 8765;
+
+	// 1 kHz IMU with a biased accelerometer, 60 Hz positions with +-5 mm of noise
+	const float dt = 0.001f, noise = 0.005f, bias = 0.2f;
+	quatf identity = {{0, 0, 0, 1}};
+	position_filter pf;
+	oposition_filter_init(&pf);
+	pf.accel_noise = 0.05f;
+
+	double meas_sq = 0, est_sq = 0;
+	int corrections = 0;
+
+	for(int i = 0; i < 10000; i++){
+		float t = i * dt;
+
+		// x sways at 0.5 Hz with 10 cm amplitude
+		float w = 2 * M_PI * 0.5f;
+		float x = 0.1f * sinf(w * t);
+		vec3f accel = {{-0.1f * w * w * sinf(w * t) + bias, 9.82f, 0}};
+
+		oposition_filter_predict_imu(&pf, dt, &identity, &accel);
+
+		if(i % 17 == 0){
+			vec3f meas = {{x + noise * (float)(2 * test_rand(&seed) - 1), 1.5f, 0}};
+			oposition_filter_correct(&pf, &meas, POW2(noise) / 3);
+
+			if(i >= 5000){
+				meas_sq += POW2(meas.x - x);
+				est_sq += POW2(pf.pos.x - x);
+				corrections++;
+			}
+		}
+	}
+
+	TAssert(pf.valid);
+	TAssert(float_eq(pf.pos.y, 1.5f, 0.001f));
+
+	// the accelerometer bias is picked up and the noise filtered out
+	TAssert(float_eq(pf.accel_bias.x, bias, 0.05f));
+	TAssert(sqrt(est_sq / corrections) < 0.5 * sqrt(meas_sq / corrections));
+
+	// coasting on the IMU alone stays close for a short while
+	vec3f start = pf.pos;
+	vec3f accel = {{bias, 9.82f, 0}};
+	for(int i = 0; i < 50; i++)
+		oposition_filter_predict_imu(&pf, dt, &identity, &accel);
+
+	vec3f predicted;
+	oposition_filter_get_predicted(&pf, 0, &predicted);
+	TAssert(float_eq(predicted.x, start.x + pf.vel.x * 0.05f, 0.01f));
+}
@@ -0,0 +1,164 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Shared Memory Transport Tests */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include "tests.h"
+#include "openhmd_ring.h"
+
+#define TEST_SHM_NAME "/openhmd-unittest"
+#define TEST_RING_NAME "/openhmd-unittest-ring"
+
+static int find_shm_device(ohmd_context* ctx)
+{
+	int num_devices = ohmd_ctx_probe(ctx);
+	for(int i = 0; i < num_devices; i++){
+		if(strncmp(ohmd_list_gets(ctx, i, OHMD_PATH), "shm:", 4) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+void test_oshm_publish_and_read()
+{
+	ohmd_context* server = ohmd_ctx_create();
+	TAssert(server);
+
+	int num_devices = ohmd_ctx_probe(server);
+	TAssert(num_devices > 0);
+
+	// the right null controller, it has a position and controls
+	ohmd_device* served = ohmd_list_open_device(server, num_devices - 1);
+	TAssert(served);
+
+	ohmd_status ret = ohmd_ctx_publish(server, TEST_SHM_NAME);
+	if(ret == OHMD_S_UNSUPPORTED){
+		ohmd_ctx_destroy(server);
+		return;
+	}
+	TAssert(ret == OHMD_S_OK);
+
+	// the server doesn't list its own devices
+	TAssert(find_shm_device(server) < 0);
+
+	ohmd_ctx_update(server);
+
+	setenv("OHMD_SHM_NAME", TEST_SHM_NAME, 1);
+	ohmd_context* client = ohmd_ctx_create();
+	TAssert(client);
+
+	int idx = find_shm_device(client);
+	TAssert(idx >= 0);
+	TAssert(strcmp(ohmd_list_gets(client, idx, OHMD_PRODUCT), "Right Controller Null Device") == 0);
+
+	ohmd_device* dev = ohmd_list_open_device(client, idx);
+	TAssert(dev);
+	ohmd_ctx_update(client);
+
+	float pos[3], controls[2];
+	TAssert(ohmd_device_getf(dev, OHMD_POSITION_VECTOR, pos) == OHMD_S_OK);
+	TAssert(float_eq(pos[0], 0.5f, 1e-6f) && pos[1] == 0 && pos[2] == 0);
+
+	int count = 0;
+	TAssert(ohmd_device_geti(dev, OHMD_CONTROL_COUNT, &count) == OHMD_S_OK);
+	TAssert(count == 2);
+	TAssert(ohmd_device_getf(dev, OHMD_CONTROLS_STATE, controls) == OHMD_S_OK);
+	TAssert(float_eq(controls[0], 0.1f, 1e-6f) && controls[1] == 1.0f);
+
+	// a device closed by the server keeps its last pose in the client
+	TAssert(ohmd_close_device(served) == 0);
+	ohmd_ctx_update(client);
+	TAssert(ohmd_device_getf(dev, OHMD_POSITION_VECTOR, pos) == OHMD_S_OK);
+	TAssert(float_eq(pos[0], 0.5f, 1e-6f));
+	TAssert(find_shm_device(client) < 0);
+
+	// and nothing is listed once the server is gone
+	ohmd_ctx_destroy(server);
+	TAssert(find_shm_device(client) < 0);
+
+	TAssert(ohmd_close_device(dev) == 0);
+	ohmd_ctx_destroy(client);
+	unsetenv("OHMD_SHM_NAME");
+}
+
+static ohmd_sensor_sample ring_sample(int i)
+{
+	ohmd_sensor_sample s = {10.0 + i * 0.001, 0.001f, {0.5f, -0.2f, 1.0f}, {0, 9.81f, 0}, {0.3f, 0, -0.4f}};
+	return s;
+}
+
+void test_oshm_external_ring()
+{
+	ohmd_ring_unlink(TEST_RING_NAME);
+
+	ohmd_ring producer;
+	TAssert(ohmd_ring_create(&producer, TEST_RING_NAME, 100) < 0); // not a power of two
+	TAssert(ohmd_ring_create(&producer, TEST_RING_NAME, 64) == 0);
+
+	// only a ring's worth fits until the consumer drains it
+	int pushed = 0;
+	for(int i = 0; i < 100; i++)
+		pushed += ohmd_ring_push(&producer, &(ohmd_sensor_sample){0}) == 0;
+	TAssert(pushed == 64 && producer.header->dropped == 36);
+
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	// updated by ohmd_ctx_update only, so the test decides when the ring is drained
+	ohmd_device_settings* settings = ohmd_device_settings_create(ctx);
+	int manual = 0;
+	ohmd_device_settings_seti(settings, OHMD_IDS_AUTOMATIC_UPDATE, &manual);
+
+	ohmd_device* ringed = open_product(ctx, "External Device", settings);
+	ohmd_device* batched = open_product(ctx, "External Device", settings);
+	ohmd_device_settings_destroy(settings);
+	TAssert(ringed && batched);
+
+	// attaching drains the zeroed samples right away, they carry no time step
+	TAssert(ohmd_device_set_data(ringed, OHMD_EXTERNAL_SENSOR_RING, TEST_RING_NAME) == OHMD_S_OK);
+	TAssert(producer.header->tail == producer.header->head);
+
+	ohmd_sensor_sample samples[300];
+	for(int i = 0; i < 300; i++)
+		samples[i] = ring_sample(i);
+
+	ohmd_sensor_samples batch = {samples, 300};
+	TAssert(ohmd_device_set_data(batched, OHMD_EXTERNAL_SENSOR_SAMPLES, &batch) == OHMD_S_OK);
+
+	// in chunks that fit, the producer replacing the ring halfway
+	for(int i = 0; i < 300; i++){
+		if(i == 150){
+			ohmd_ring_close(&producer);
+			TAssert(ohmd_ring_create(&producer, TEST_RING_NAME, 128) == 0);
+			ohmd_ctx_update(ctx); // notices the old ring is gone
+		}
+
+		TAssert(ohmd_ring_push(&producer, samples + i) == 0);
+		if(i % 50 == 49)
+			ohmd_ctx_update(ctx);
+	}
+
+	ohmd_ctx_update(ctx);
+	TAssert(producer.header->tail == producer.header->head);
+
+	float a[4], b[4];
+	TAssert(ohmd_device_getf(ringed, OHMD_ROTATION_QUAT, a) == OHMD_S_OK);
+	TAssert(ohmd_device_getf(batched, OHMD_ROTATION_QUAT, b) == OHMD_S_OK);
+	for(int i = 0; i < 4; i++)
+		TAssert(float_eq(a[i], b[i], 1e-6f));
+	TAssert(fabsf(a[3]) < 0.999f);
+
+	TAssert(ohmd_device_set_data(ringed, OHMD_EXTERNAL_SENSOR_RING, NULL) == OHMD_S_OK);
+
+	ohmd_ctx_destroy(ctx);
+	ohmd_ring_close(&producer);
+	ohmd_ring_unlink(TEST_RING_NAME);
+}
@@ -0,0 +1,88 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Single Producer, Single Consumer Queue Tests */
+
+#include "tests.h"
+
+#define ENTRIES 100000
+
+typedef struct {
+	uint32_t seq;
+	double time;
+} test_entry;
+
+static unsigned int producer(void* arg)
+{
+	spsc_queue* queue = (spsc_queue*)arg;
+
+	// retries when full, so every entry makes it through
+	for(uint32_t i = 0; i < ENTRIES; ){
+		test_entry entry = {i, i * 0.001};
+		if(ospsc_queue_push(queue, &entry))
+			i++;
+	}
+
+	return 0;
+}
+
+void test_ospsc_queue_push_pop()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	spsc_queue queue;
+	TAssert(ospsc_queue_init(&queue, ctx, sizeof(test_entry), 5));
+	TAssert(queue.capacity == 8);
+
+	// full and empty
+	test_entry entry = {0, 0};
+	for(int i = 0; i < 8; i++){
+		entry.seq = i;
+		TAssert(ospsc_queue_push(&queue, &entry));
+	}
+	TAssert(!ospsc_queue_push(&queue, &entry));
+	TAssert(ohmd_atomic_load(&queue.dropped) == 1);
+
+	for(int i = 0; i < 8; i++){
+		TAssert(ospsc_queue_pop(&queue, &entry));
+		TAssert(entry.seq == (uint32_t)i);
+	}
+	TAssert(!ospsc_queue_pop(&queue, &entry));
+
+	ospsc_queue_destroy(&queue);
+	ohmd_ctx_destroy(ctx);
+}
+
+void test_ospsc_queue_threads()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	spsc_queue queue;
+	TAssert(ospsc_queue_init(&queue, ctx, sizeof(test_entry), 64));
+
+	ohmd_thread* thread = ohmd_create_thread(ctx, producer, &queue);
+	TAssert(thread);
+
+	// entries arrive complete and in order
+	uint32_t next = 0;
+	while(next < ENTRIES){
+		test_entry entry;
+		if(!ospsc_queue_pop(&queue, &entry))
+			continue;
+
+		TAssert(entry.seq == next);
+		TAssert(entry.time == next * 0.001);
+		next++;
+	}
+
+	ohmd_destroy_thread(thread);
+	TAssert(!ospsc_queue_pop(&queue, &(test_entry){0, 0}));
+
+	ospsc_queue_destroy(&queue);
+	ohmd_ctx_destroy(ctx);
+}
@@ -21,6 +21,12 @@
 bool float_eq(float a, float b, float t);
 bool vec3f_eq(vec3f v1, vec3f v2, float t);
 
+// deterministic pseudo random number in [0, 1), advances the seed in state
+double test_rand(uint32_t* state);
+
+// probes and opens the first device with the given product name, settings may be NULL for the defaults
+ohmd_device* open_product(ohmd_context* ctx, const char* product, ohmd_device_settings* settings);
+
 // vec3f tests
 void test_ovec3f_normalize_me();
 void test_ovec3f_get_length();
@@ -40,8 +46,61 @@ void test_oquatf_diff();
 
 void test_oquatf_get_mat4x4();
 
+// fusion tests
+void test_ofusion_eskf_gyro_bias();
+void test_ofusion_eskf_initial_tilt();
+void test_ofusion_external_samples();
+void test_opreint_get();
+
+// clock sync tests
+void test_oclock_sync_drift_and_wrap();
+
+// pose filter tests
+void test_opose_filter_jitter_and_lag();
+void test_opose_filter_rotation();
+
+// position filter tests
+void test_oposition_filter_fusion();
+
+// frame timing tests
+void test_oframe_timing_vsync();
+void test_oframe_timing_no_present();
+
+// worker pool tests
+void test_oworker_pool_run();
+void test_oworker_pool_ctx_update();
+
+// shared memory tests
+void test_oshm_publish_and_read();
+void test_oshm_external_ring();
+
+// distortion tests
+void test_odistortion_mesh();
+void test_odistortion_bake_map();
+void test_odistortion_area_mesh();
+void test_odistortion_frustum();
+void test_odistortion_timewarp();
+void test_odistortion_points();
+void test_odistortion_shading_rate_map();
+void test_odistortion_composite();
+
 // high-level tests
 void test_highlevel_open_close_device();
 void test_highlevel_open_close_many_devices();
+void test_highlevel_device_registries();
+void test_highlevel_open_device_async();
+void test_highlevel_open_device_async_update();
+void test_highlevel_open_device_async_error();
+void test_highlevel_close_while_updating();
+void test_highlevel_driver_selection();
+void test_highlevel_control_events();
+
+// allocation tests
+void test_omem_pool_recycle();
+void test_highlevel_update_no_alloc();
+
+// spsc queue tests
+void test_ospsc_queue_push_pop();
+void test_ospsc_queue_threads();
 
 #endif
@@ -0,0 +1,104 @@
+/*
+ * OpenHMD - Free and Open Source API and drivers for immersive technology.
+ * Copyright (C) 2026 OpenHMD contributors.
+ * Distributed under the Boost 1.0 licence, see LICENSE for full text.
+ */
+
+/* Unit Tests - Worker Pool Tests */
+
+#include <string.h>
+#include "tests.h"
+
+#define JOBS 100
+
+typedef struct {
+	ohmd_mutex* mutex;
+	int runs[JOBS];
+} job_counts;
+
+static void count_job(void* arg, int index)
+{
+	job_counts* counts = (job_counts*)arg;
+
+	ohmd_lock_mutex(counts->mutex);
+	counts->runs[index]++;
+	ohmd_unlock_mutex(counts->mutex);
+}
+
+void test_oworker_pool_run()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	worker_pool* pool = oworker_pool_create(ctx, 4);
+	TAssert(pool);
+	TAssert(oworker_pool_get_threads(pool) == 4);
+
+	job_counts counts;
+	memset(&counts, 0, sizeof(counts));
+	counts.mutex = ohmd_create_mutex(ctx);
+
+	// every job runs exactly once per batch, whatever the count
+	for(int batch = 0; batch < 50; batch++)
+		oworker_pool_run(pool, count_job, &counts, batch % 2 ? JOBS : batch % 5);
+
+	int expected[JOBS] = {0};
+	for(int batch = 0; batch < 50; batch++){
+		int count = batch % 2 ? JOBS : batch % 5;
+		for(int i = 0; i < count; i++)
+			expected[i]++;
+	}
+
+	for(int i = 0; i < JOBS; i++)
+		TAssert(counts.runs[i] == expected[i]);
+
+	oworker_pool_destroy(pool);
+	ohmd_destroy_mutex(counts.mutex);
+	ohmd_ctx_destroy(ctx);
+}
+
+void test_oworker_pool_ctx_update()
+{
+	ohmd_context* ctx = ohmd_ctx_create();
+	TAssert(ctx);
+
+	TAssert(ohmd_ctx_set_update_threads(ctx, 0) == OHMD_S_INVALID_PARAMETER);
+	TAssert(ohmd_ctx_set_update_threads(ctx, 3) == OHMD_S_OK);
+
+	ohmd_device_settings* settings = ohmd_device_settings_create(ctx);
+	int manual = 0;
+	ohmd_device_settings_seti(settings, OHMD_IDS_AUTOMATIC_UPDATE, &manual);
+
+	// the dummy devices share a connection, the external ones another, the rest are automatic
+	int num_devices = ohmd_ctx_probe(ctx);
+	ohmd_device* devices[32];
+	int num_open = 0;
+	for(int i = 0; i < num_devices && num_open < 32; i++){
+		const char* product = ohmd_list_gets(ctx, i, OHMD_PRODUCT);
+		if(strstr(product, "Null Device") || strcmp(product, "External Device") == 0){
+			devices[num_open++] = ohmd_list_open_device_s(ctx, i, settings);
+			devices[num_open++] = ohmd_list_open_device_s(ctx, i, settings);
+		}
+	}
+	TAssert(num_open >= 4);
+
+	for(int i = 0; i < 100; i++)
+		ohmd_ctx_update(ctx);
+
+	TAssert(ctx->num_update_groups == 2);
+	TAssert(ctx->update_groups[2] == num_open);
+
+	for(int i = 0; i < num_open; i++){
+		float quat[4];
+		TAssert(ohmd_device_getf(devices[i], OHMD_ROTATION_QUAT, quat) == OHMD_S_OK);
+	}
+
+	// closing regroups, going back to one thread works too
+	TAssert(ohmd_close_device(devices[0]) == 0);
+	TAssert(ohmd_ctx_set_update_threads(ctx, 1) == OHMD_S_OK);
+	ohmd_ctx_update(ctx);
+	TAssert(ctx->update_groups[ctx->num_update_groups] == num_open - 1);
+
+	ohmd_device_settings_destroy(settings);
+	ohmd_ctx_destroy(ctx);
+}